@@ -6,20 +6,17 @@
 *
 * Modified:
 * 2015-06-22 : File created.
+* 2026-10-18 : Keep the running CRC in a local variable, CRC_Calculate is reentrant.
 */
 
 #include "CRC.h"
 
-/* Internal variable
- * Current CRC value, for iteration
- */
-static uint32_t Current_CRC;
-
 /*
  * Internal function.
  * Calculate CRC value for each 32-bit.
+ * Current_CRC : CRC value before this word, returns the updated value.
  */
-static void CRC32(uint32_t Input_Data)
+static uint32_t CRC32(uint32_t Current_CRC, uint32_t Input_Data)
 {
   uint8_t bindex;
 
@@ -32,17 +29,20 @@ static void CRC32(uint32_t Input_Data)
     else
       Current_CRC <<= 1;
   }
+
+  return Current_CRC;
 }
 
 /*
 * Internal function.
 * Calculate CRC value for 16-bit.
+* Current_CRC : CRC value before this data, returns the updated value.
 */
-static void CRC16(uint16_t Input_Data)
+static uint32_t CRC16(uint32_t Current_CRC, uint16_t Input_Data)
 {
   uint8_t bindex;
 
-  Current_CRC ^= (Input_Data << 16);
+  Current_CRC ^= (uint32_t)Input_Data << 16;
 
   for (bindex = 0; bindex < 16; bindex++)
   {
@@ -51,17 +51,20 @@ static void CRC16(uint16_t Input_Data)
     else
       Current_CRC <<= 1;
   }
+
+  return Current_CRC;
 }
 
 /*
 * Internal function.
 * Calculate CRC value for 8-bit.
+* Current_CRC : CRC value before this data, returns the updated value.
 */
-static void CRC8(uint8_t Input_Data)
+static uint32_t CRC8(uint32_t Current_CRC, uint8_t Input_Data)
 {
   uint8_t bindex;
 
-  Current_CRC ^= (Input_Data << 24);
+  Current_CRC ^= (uint32_t)Input_Data << 24;
 
   for (bindex = 0; bindex < 8; bindex++)
   {
@@ -70,6 +73,8 @@ static void CRC8(uint8_t Input_Data)
     else
       Current_CRC <<= 1;
   }
+
+  return Current_CRC;
 }
 
 /*
@@ -84,6 +89,7 @@ static void CRC8(uint8_t Input_Data)
 */
 uint32_t CRC_Calculate(const uint8_t *pBuffer, uint16_t BufferLength)
 {
+  uint32_t Current_CRC;
   uint16_t i;
 
   /* Initialize current CRC value */
@@ -91,23 +97,23 @@ uint32_t CRC_Calculate(const uint8_t *pBuffer, uint16_t BufferLength)
 
   for (i = 0; i < (BufferLength / 4); i++)
   {
-    CRC32(((uint32_t)pBuffer[4 * i] << 24) | ((uint32_t)pBuffer[4 * i + 1] << 16) | ((uint32_t)pBuffer[4 * i + 2] << 8) | (uint32_t)pBuffer[4 * i + 3]);
+    Current_CRC = CRC32(Current_CRC, ((uint32_t)pBuffer[4 * i] << 24) | ((uint32_t)pBuffer[4 * i + 1] << 16) | ((uint32_t)pBuffer[4 * i + 2] << 8) | (uint32_t)pBuffer[4 * i + 3]);
   }
   /* last bytes specific handling */
   if ((BufferLength % 4) != 0)
   {
     if (BufferLength % 4 == 1)
     {
-      CRC8((uint8_t)pBuffer[4 * i]);
+      Current_CRC = CRC8(Current_CRC, (uint8_t)pBuffer[4 * i]);
     }
     if (BufferLength % 4 == 2)
     {
-      CRC16((uint16_t)pBuffer[4 * i] << 8 | (uint16_t)pBuffer[4 * i + 1]);
+      Current_CRC = CRC16(Current_CRC, (uint16_t)pBuffer[4 * i] << 8 | (uint16_t)pBuffer[4 * i + 1]);
     }
     if (BufferLength % 4 == 3)
     {
-      CRC16(((uint16_t)pBuffer[4 * i] << 8) | (uint16_t)pBuffer[4 * i + 1]);
-      CRC8(pBuffer[4 * i + 2]);
+      Current_CRC = CRC16(Current_CRC, ((uint16_t)pBuffer[4 * i] << 8) | (uint16_t)pBuffer[4 * i + 1]);
+      Current_CRC = CRC8(Current_CRC, pBuffer[4 * i + 2]);
     }
   }
 
@@ -6,6 +6,8 @@
 * 
 * Modified:
 * 2015-06-22 : File created.
+* 2026-10-18 : Guard basic type definitions with TypeDef.h macros.
+*              CRC_Calculate no longer uses static state, it is reentrant.
 */
 
 #ifndef CRC_H
@@ -15,9 +17,18 @@
 extern "C" {
 #endif  
 
+#ifndef TYPE_UINT8_T
+#define TYPE_UINT8_T
 typedef unsigned char uint8_t;
+#endif
+#ifndef TYPE_UINT16_T
+#define TYPE_UINT16_T
 typedef unsigned short uint16_t;
+#endif
+#ifndef TYPE_UINT32_T
+#define TYPE_UINT32_T
 typedef unsigned int uint32_t;
+#endif
 
 /* CRC generating polynomial */
 #define CRC_POLY 0x04C11DB7
@@ -37,6 +48,8 @@ typedef unsigned int uint32_t;
 *
 * Return :
 * CRC value.
+*
+* Reentrant, can be called from interrupts and main loop at the same time.
 */
 uint32_t CRC_Calculate(const uint8_t *pBuffer, uint16_t BufferLength);
 
@@ -10,13 +10,31 @@
  * \note 某些低端MCU（如51）没有硬件I2C模块，
  *       故需要使用GPIO实现I2C协议
  *
- * \todo 目前未实现连续读多个字节数据
- *
  * 修改记录：\n
  *
  * 2015-09-27 :\n
  *   -修改注释格式使其可以使用Doxygen\n
  *   -为内部函数增加static限定\n
+ *
+ * 2026-10-18 :\n
+ *   -增加I2CReadMultiBytes、I2CReadRegs，连续读多个字节\n
+ *   -I2CReadByte、I2CReadReg改为调用上述函数\n
+ *   -延时改为按硬件计数器计时，增加I2CSetSpeed选择总线速度并自动校准\n
+ *   -SCLTestOut返回实际的SCL频率\n
+ *   -SCL变为高电平后回读，支持从设备时钟延展，超时返回I2CERROR\n
+ *   -SCL高电平时间取规范的最小值，读取ACK不再循环等待\n
+ *   -增加I2CBatch，连续执行多个读写操作，之间使用重复Start\n
+ *   -增加总线对象I2CBus（引脚操作、时序、统计信息），增加以I2CBus为参数的I2CBus*系列函数，支持多个总线\n
+ *   -原有函数改为使用默认总线I2CDefaultBus\n
+ *   -增加I2C_SINGLE_BUS、I2C_NO_DEFAULT_BUS宏定义\n
+ *   -增加I2C_HOST编译选项，支持在Linux主机上仿真运行\n
+ *   -增加I2C_UNROLL编译选项，单总线时按位展开发送和接收，增加I2C_BDATA宏定义\n
+ *   -增加I2CWriteBlock，连续发送头部和数据两段，数据不需要复制到同一数组\n
+ *   -增加I2C_STATS编译选项：字节数、分阶段的无应答次数、时钟延展时间、总线占用时间，及最近传输的记录\n
+ *   -增加I2CBusResetStats、I2CBusBusyPercent、I2CBusTraceDump\n
+ *   -定义HAL_I2C_TICKS()高-低-高读取使用的暂存变量\n
+ *   -I2CBus增加polling，ACK轮询中的地址无应答计入stats.polls，不计入nacks，不记录传输段\n
+ *   -I2C_STATS的总线占用和时钟延展时间改为HAL_I2C_STATS_TIME()的计数，只在Start、Stop时读取时间\n
  * 
  */
  
@@ -29,58 +47,369 @@ typedef enum
 	NOACK  /**< NOACK */
 } ACK_State;
  
+/** 校准和SCLTestOut输出的时钟个数 */
+#define I2C_TEST_PERIODS 16
+
+/** 循环延时校准时使用的循环次数 */
+#define I2C_CAL_COUNT 32
+
+/** 各速度对应的SCL频率除以I2C_TEST_PERIODS */
+static const uint16_t _I2CSpeedHz[] = { 100000UL / I2C_TEST_PERIODS, 400000UL / I2C_TEST_PERIODS, 1000000UL / I2C_TEST_PERIODS };
+
+/** 各速度下规范规定的SCL高电平最小时间(ns) */
+static const uint16_t _I2CHighNs[] = { 4000, 600, 260 };
+
+/** 纳秒换算为计数值，向上取整 */
+#define I2C_NS_TO_TICKS(ns) ((HAL_I2C_TICK_HZ / 1000UL * (ns) + 999999UL) / 1000000UL)
+
+/** 时钟延展超时的计数值 */
+#define I2C_STRETCH_TICKS (HAL_I2C_TICK_HZ / 1000UL * I2C_STRETCH_TIMEOUT / 1000UL)
+
+#ifdef I2C_DELAY_TIMER
+/* SCL低电平时间的一半和高电平时间的默认值（计数值），为100kHz */
+#define I2C_DEFAULT_LOW  ((uint16_t)I2C_NS_TO_TICKS(3000))
+#define I2C_DEFAULT_HIGH ((uint16_t)I2C_NS_TO_TICKS(4000))
+/* 从当前时刻开始计时 */
+#define I2C_DELAY_START(bus) ((bus)->next = HAL_I2C_TICKS())
+#else
+/* SCL低电平时间的一半和高电平时间的默认值（循环次数） */
+#define I2C_DEFAULT_LOW  I2C_DELAY_COUNT
+#define I2C_DEFAULT_HIGH (I2C_DELAY_COUNT * 2)
+#define I2C_DELAY_START(bus) ((void)(bus))
+#endif
+
+#ifdef I2C_SINGLE_BUS
+/* 只有一个总线，直接使用HAL宏定义，位操作中没有函数指针调用 */
+#define I2C_SCL_W(bus, STATE) HAL_SCL_W(STATE)
+#define I2C_SDA_W(bus, STATE) HAL_SDA_W(STATE)
+#define I2C_SCL_R(bus)        (HAL_SCL_R)
+#define I2C_SDA_R(bus)        (HAL_SDA_R)
+#else
+#define I2C_SCL_W(bus, STATE) ((bus)->ops->SclWrite((bus)->hw, STATE))
+#define I2C_SDA_W(bus, STATE) ((bus)->ops->SdaWrite((bus)->hw, STATE))
+#define I2C_SCL_R(bus)        ((bus)->ops->SclRead((bus)->hw))
+#define I2C_SDA_R(bus)        ((bus)->ops->SdaRead((bus)->hw))
+#endif
+
+#ifdef I2C_STATS
+/* statsState的位 */
+#define I2C_STATS_IN_TRANS 0x01  /* Start之后，Stop之前 */
+#define I2C_STATS_IN_TRACE 0x02  /* 已开始一个传输段记录 */
+
+/* 每个字节只加1，总线占用时间在Start和Stop时累计 */
+#define I2C_STATS_BYTE(bus) ((bus)->stats.bytes++)
+
+#define I2C_STATS_START(bus)              _I2CStatsStart(bus)
+#define I2C_STATS_STOP(bus)               _I2CStatsStop(bus)
+#define I2C_STATS_ADDRESS(bus, addr, ack) _I2CStatsAddress(bus, addr, ack)
+#define I2C_STATS_STRETCH(bus, wait)      _I2CStatsStretch(bus, wait)
+
+/* HAL_I2C_STATS_TIME()每个计数对应的HAL_I2C_TICKS()计数值，及每毫秒的HAL_I2C_STATS_TIME()计数 */
+#define I2C_STATS_TIME_TICKS  (HAL_I2C_TICK_HZ / HAL_I2C_STATS_TIME_HZ)
+#define I2C_STATS_TIME_PER_MS (HAL_I2C_STATS_TIME_HZ / 1000UL)
+
+#if HAL_I2C_STATS_TIME_HZ < 1000 || HAL_I2C_STATS_TIME_HZ % 1000 != 0
+#error "HAL_I2C_STATS_TIME_HZ必须为1000的整数倍"
+#endif
+#if HAL_I2C_TICK_HZ / HAL_I2C_STATS_TIME_HZ < 1 || HAL_I2C_TICK_HZ / HAL_I2C_STATS_TIME_HZ > 65535
+#error "HAL_I2C_TICK_HZ / HAL_I2C_STATS_TIME_HZ必须在1~65535之间"
+#endif
+#if I2C_TRACE_SIZE > 128 || (I2C_TRACE_SIZE & (I2C_TRACE_SIZE - 1)) != 0
+#error "I2C_TRACE_SIZE必须为2的整数次幂且不超过128，或为0"
+#endif
+
+/* I2CDefaultBus中stats及之后成员的初值 */
+#if I2C_TRACE_SIZE > 0
+#define I2C_STATS_INIT { 0, 0, 0, 0, 0, 0, 0, 0 }, 0, 0, 0, 0, 0, 0, 0, { { 0, 0, 0, 0 } }
+#else
+#define I2C_STATS_INIT { 0, 0, 0, 0, 0, 0, 0, 0 }, 0, 0, 0
+#endif
+#else
+#define I2C_STATS_BYTE(bus)               ((void)0)
+#define I2C_STATS_START(bus)              ((void)0)
+#define I2C_STATS_STOP(bus)               ((void)0)
+#define I2C_STATS_ADDRESS(bus, addr, ack) ((void)0)
+#define I2C_STATS_STRETCH(bus, wait)      ((void)0)
+
+#define I2C_STATS_INIT { 0, 0, 0, 0 }
+#endif
+
+#if defined(I2C_UNROLL) && !defined(I2C_SINGLE_BUS)
+#error "I2C_UNROLL需要同时定义I2C_SINGLE_BUS"
+#endif
+
+#ifdef I2C_SINGLE_BUS
+/* 字节收发中内联的_I2CDelay和_I2CSclHigh，计数器延时时上一次延时的结束时刻在局部变量next中，字节结束时写回bus->next */
+#ifdef I2C_DELAY_TIMER
+#define I2C_LOCAL_NEXT
+
+#define I2C_DELAY(bus, count) do \
+	{ \
+		uint16_t n_ = next + (count); \
+		if((int16_t)(HAL_I2C_TICKS() - n_) >= 0) \
+		{ \
+			next = HAL_I2C_TICKS(); \
+		} \
+		else \
+		{ \
+			while((int16_t)(HAL_I2C_TICKS() - n_) < 0); \
+			next = n_; \
+		} \
+	} while(0)
+
+/* 释放SCL，已变为高电平时不调用_I2CSclHigh */
+#define I2C_SCL_HIGH(bus) do \
+	{ \
+		HAL_SCL_W(1); \
+		if(HAL_SCL_R) \
+		{ \
+			next = HAL_I2C_TICKS(); \
+		} \
+		else \
+		{ \
+			_I2CSclHigh(bus); \
+			next = (bus)->next; \
+		} \
+	} while(0)
+#else
+#define I2C_DELAY(bus, count) do \
+	{ \
+		volatile uint16_t k_; \
+		for(k_ = 0; k_ < (count); k_++); \
+	} while(0)
+
+#define I2C_SCL_HIGH(bus) do \
+	{ \
+		HAL_SCL_W(1); \
+		if(!HAL_SCL_R) \
+			_I2CSclHigh(bus); \
+	} while(0)
+#endif
+#else
+/* 多个总线时调用函数 */
+#define I2C_DELAY(bus, count) _I2CDelay(bus, count)
+#define I2C_SCL_HIGH(bus)     _I2CSclHigh(bus)
+#endif
+
+#ifdef I2C_UNROLL
+
+/* 发送一位，MASK为常量，只测试_I2CBits的固定位 */
+#define I2C_SEND_BIT(MASK) \
+	HAL_SCL_W(0); \
+	I2C_DELAY(bus, low); \
+	HAL_SDA_W((_I2CBits & (MASK)) ? 1 : 0); \
+	I2C_DELAY(bus, low); \
+	I2C_SCL_HIGH(bus); \
+	I2C_DELAY(bus, high)
+
+/* 接收一位，MASK为常量，只设置_I2CBits的固定位 */
+#define I2C_GET_BIT(MASK) \
+	HAL_SCL_W(0); \
+	I2C_DELAY(bus, low); \
+	I2C_DELAY(bus, low); \
+	I2C_SCL_HIGH(bus); \
+	I2C_DELAY(bus, high); \
+	if(HAL_SDA_R) \
+		_I2CBits |= (MASK)
+
+/* 正在发送或接收的字节 */
+static uint8_t I2C_BDATA _I2CBits;
+#endif
+
+#ifdef HAL_I2C_TICKS_VARS
+/* HAL_I2C_TICKS()使用的暂存变量 */
+HAL_I2C_TICKS_VARS;
+#endif
+
 /* 内部使用的函数声明 */
-static void _I2CDelay(void);
-static void _I2CStart(void);
-static void _I2CStop(void);
-static ACK_State _I2CSendAddress(uint8_t address, uint8_t wr);
-static ACK_State _I2CSendByte(uint8_t databyte);
-static uint8_t _I2CGetByte(void);
+static void _I2CDelay(I2CBus * bus, uint16_t count);
+static void _I2CSclHigh(I2CBus * bus);
+static uint32_t _I2CClockOut(I2CBus * bus);
+static void _I2CStart(I2CBus * bus);
+static void _I2CStop(I2CBus * bus);
+static ACK_State _I2CSendAddress(I2CBus * bus, uint8_t address, uint8_t wr);
+static ACK_State _I2CSendByte(I2CBus * bus, uint8_t databyte);
+static ACK_State _I2CBatchOp(I2CBus * bus, I2COp * op, uint8_t * writing, uint8_t * nextReg);
+static uint8_t _I2CGetByte(I2CBus * bus, ACK_State ack);
+#ifdef I2C_STATS
+static void _I2CStatsStart(I2CBus * bus);
+static void _I2CStatsStop(I2CBus * bus);
+static void _I2CStatsStretch(I2CBus * bus, uint32_t wait);
+static void _I2CStatsAddress(I2CBus * bus, uint8_t addr, ACK_State ack);
+#if I2C_TRACE_SIZE > 0
+static void _I2CTraceClose(I2CBus * bus);
+#endif
+#endif
+
+#ifndef I2C_NO_DEFAULT_BUS
+#ifndef I2C_SINGLE_BUS
+/* 默认总线的引脚操作，使用HAL宏定义 */
+static void _I2CHalSclWrite(void * hw, uint8_t state)
+{
+	(void)hw;
+	HAL_SCL_W(state);
+}
+
+static void _I2CHalSdaWrite(void * hw, uint8_t state)
+{
+	(void)hw;
+	HAL_SDA_W(state);
+}
+
+static uint8_t _I2CHalSclRead(void * hw)
+{
+	(void)hw;
+	return HAL_SCL_R ? 1 : 0;
+}
+
+static uint8_t _I2CHalSdaRead(void * hw)
+{
+	(void)hw;
+	return HAL_SDA_R ? 1 : 0;
+}
+
+static const I2CBusOps _I2CHalOps = { _I2CHalSclWrite, _I2CHalSdaWrite, _I2CHalSclRead, _I2CHalSdaRead };
+
+/** 默认总线，使用HAL宏定义 */
+I2CBus I2CDefaultBus = { &_I2CHalOps, 0, I2C_DEFAULT_LOW, I2C_DEFAULT_HIGH, 0, 0, 0, I2C_STATS_INIT };
+#else
+/** 默认总线，引脚操作直接使用HAL宏定义 */
+I2CBus I2CDefaultBus = { 0, 0, I2C_DEFAULT_LOW, I2C_DEFAULT_HIGH, 0, 0, 0, I2C_STATS_INIT };
+#endif
+#endif
 
 /**
- * 持续输出时钟信号，方便示波器观察目前的总线速度
+ * 初始化总线对象，速度为100kHz（循环延时时为I2C_DELAY_COUNT次循环），统计信息清零
+ *
+ * \param bus : 总线对象指针
+ * \param ops : 引脚操作，定义I2C_SINGLE_BUS时可以为空
+ * \param hw  : 引脚操作使用的参数
  *
  */
-void SCLTestOut()
+void I2CBusInit(I2CBus * bus, const I2CBusOps * ops, void * hw)
 {
-  HAL_SCL_W(0);
-  _I2CDelay();
-	HAL_SCL_W(0);
-	_I2CDelay();
-  HAL_SCL_W(1);
-  _I2CDelay();
-	HAL_SCL_W(1);
-	_I2CDelay();
+	bus->ops = ops;
+	bus->hw = hw;
+	bus->low = I2C_DEFAULT_LOW;
+	bus->high = I2C_DEFAULT_HIGH;
+	bus->next = 0;
+	bus->timeout = 0;
+	bus->polling = 0;
+	I2CBusResetStats(bus);
+}
+
+
+/**
+ * 设置总线速度，同时测量实际的时钟周期进行校准，上电初始化时调用一次即可。
+ * SCL高电平时间取规范的最小值，其余时间为低电平；从设备时钟延展时总线相应变慢。
+ * 校准时在SCL上输出几十个时钟信号，SDA保持高电平，不会产生Start信号
+ * 
+ * \param bus   : 总线对象指针
+ * \param speed : 总线速度
+ *
+ * \return 执行结果
+ * \retval I2COK    : 成功
+ * \retval I2CERROR : MCU速度不足，达不到指定速度，此时以能达到的最高速度运行
+ *
+ * \note 能达到的最高速度见I2C_UNROLL处的表。默认配置（多总线、计数器延时、未定义I2C_UNROLL）
+ * 在STC15 1T @11.0592MHz上约28kHz，I2C_SPEED_100K即返回I2CERROR；
+ * 需要100kHz时定义I2C_SINGLE_BUS和I2C_UNROLL，或使用更快的MCU
+ *
+ */
+I2CResult I2CBusSetSpeed(I2CBus * bus, I2CSpeed speed)
+{
+	uint32_t target, high, t0;
+#ifndef I2C_DELAY_TIMER
+	uint32_t t1, n;
+#endif
+	
+	/* I2C_TEST_PERIODS个时钟周期的计数值；高电平取规范的最小值，其余时间为低电平 */
+	target = HAL_I2C_TICK_HZ / _I2CSpeedHz[speed];
+	high = I2C_NS_TO_TICKS(_I2CHighNs[speed]);
+	
+#ifdef I2C_DELAY_TIMER
+	t0 = (target + I2C_TEST_PERIODS - 1) / I2C_TEST_PERIODS;
+	bus->high = (uint16_t)high;
+	bus->low = t0 > high ? (uint16_t)((t0 - high + 1) / 2) : 0;
+	/* 端口操作的时间包含在延时中，实测超出1/8以上时认为达不到 */
+	t0 = _I2CClockOut(bus);
+	return t0 <= target + target / 8 ? I2COK : I2CERROR;
+#else
+	/* 周期随循环次数线性增加，分别测量0次和I2C_CAL_COUNT次循环的周期 */
+	bus->low = 0;
+	bus->high = 0;
+	t0 = _I2CClockOut(bus);
+	bus->low = I2C_CAL_COUNT;
+	bus->high = I2C_CAL_COUNT;
+	t1 = _I2CClockOut(bus);
+	
+	if(t0 >= target)
+	{
+		bus->low = 0;
+		bus->high = 0;
+		return I2CERROR;
+	}
+	if(t1 <= t0)
+		t1 = t0 + 1;
+	/* 每个周期3次延时，求出每个周期的总循环次数，再按高电平时间占周期的比例（/256）分配 */
+	n = ((target - t0) * I2C_CAL_COUNT * 3 + (t1 - t0) - 1) / (t1 - t0);
+	if(n > 0x2FFFDUL)
+		n = 0x2FFFDUL;
+	high = n * (high * I2C_TEST_PERIODS * 256 / target) / 256;
+	bus->high = high > 0xFFFF ? 0xFFFF : (uint16_t)high;
+	bus->low = (uint16_t)((n - high + 1) / 2);
+	return I2COK;
+#endif
+}
+
+
+/**
+ * 输出16个时钟信号并测量实际的SCL频率，可循环调用以便示波器观察
+ *
+ * \param bus : 总线对象指针
+ *
+ * \return SCL频率(Hz)
+ *
+ */
+uint32_t I2CBusSCLTestOut(I2CBus * bus)
+{
+	uint32_t ticks = _I2CClockOut(bus);
+	
+	if(ticks == 0)
+		return 0;
+	/* 频率 = 计数器频率 * 周期数 / 计数值，分两步计算避免溢出 */
+	return HAL_I2C_TICK_HZ / ticks * I2C_TEST_PERIODS + HAL_I2C_TICK_HZ % ticks * I2C_TEST_PERIODS / ticks;
 }
 
 
 /**
  * 发送一个字节数据
  * 
- * \param address: 从设备地址
- * \param I2Cdata: 需要发送的数据
+ * \param bus     : 总线对象指针
+ * \param address : 从设备地址
+ * \param I2Cdata : 需要发送的数据
  *
  * \return 执行结果
  * \retval I2COK    : 成功
  * \retval I2CERROR : 失败
  *
  */
-I2CResult I2CWriteByte(uint8_t address, uint8_t I2Cdata)
+I2CResult I2CBusWriteByte(I2CBus * bus, uint8_t address, uint8_t I2Cdata)
 {
-	_I2CStart();
+	_I2CStart(bus);
 	
-	if(_I2CSendAddress(address, 0) == NOACK)
+	if(_I2CSendAddress(bus, address, 0) == NOACK)
 	{
-		_I2CStop();
+		_I2CStop(bus);
 		return I2CERROR;
 	}
-	if(_I2CSendByte(I2Cdata) == NOACK)
+	if(_I2CSendByte(bus, I2Cdata) == NOACK)
 	{
-		_I2CStop();
+		_I2CStop(bus);
 		return I2CERROR;
 	}
 	
-	_I2CStop();
+	_I2CStop(bus);
 	return I2COK;
 }
 	
@@ -88,6 +417,7 @@ I2CResult I2CWriteByte(uint8_t address, uint8_t I2Cdata)
 /**
  * 发送多个字节数据
  * 
+ * \param bus     : 总线对象指针
  * \param address : 从设备地址
  * \param count   : 数据长度
  * \param I2Cdata : 需要发送的数据数组
@@ -97,27 +427,27 @@ I2CResult I2CWriteByte(uint8_t address, uint8_t I2Cdata)
  * \retval I2CERROR : 失败
  *
  */
-I2CResult I2CWriteMultiBytes(uint8_t address, uint8_t count, uint8_t I2Cdata[])
+I2CResult I2CBusWriteMultiBytes(I2CBus * bus, uint8_t address, uint8_t count, uint8_t I2Cdata[])
 {
 	uint8_t i;
 	
-	_I2CStart();
+	_I2CStart(bus);
 	
-	if(_I2CSendAddress(address, 0) == NOACK)
+	if(_I2CSendAddress(bus, address, 0) == NOACK)
 	{
-		_I2CStop();
+		_I2CStop(bus);
 		return I2CERROR;
 	}
 	for(i = 0; i < count; i++)
 	{
-		if(_I2CSendByte(I2Cdata[i]) == NOACK)
+		if(_I2CSendByte(bus, I2Cdata[i]) == NOACK)
 		{
-			_I2CStop();
+			_I2CStop(bus);
 			return I2CERROR;
 		}
 	}
 
-	_I2CStop();
+	_I2CStop(bus);
 	return I2COK;
 }
 
@@ -125,6 +455,7 @@ I2CResult I2CWriteMultiBytes(uint8_t address, uint8_t count, uint8_t I2Cdata[])
 /**
  * 写寄存器，相当于先发送寄存器地址，再发送数据
  * 
+ * \param bus     : 总线对象指针
  * \param address : 从设备地址
  * \param reg     : 寄存器地址
  * \param I2Cdata : 需要发送的数据
@@ -134,62 +465,103 @@ I2CResult I2CWriteMultiBytes(uint8_t address, uint8_t count, uint8_t I2Cdata[])
  * \retval I2CERROR : 失败
  *
  */
-I2CResult I2CWriteReg(uint8_t address, uint8_t reg, uint8_t I2Cdata)
+I2CResult I2CBusWriteReg(I2CBus * bus, uint8_t address, uint8_t reg, uint8_t I2Cdata)
 {
-	_I2CStart();
+	_I2CStart(bus);
 	
-	if(_I2CSendAddress(address, 0) == NOACK)
+	if(_I2CSendAddress(bus, address, 0) == NOACK)
 	{
-		_I2CStop();
+		_I2CStop(bus);
 		return I2CERROR;
 	}
-	if(_I2CSendByte(reg) == NOACK)
+	if(_I2CSendByte(bus, reg) == NOACK)
 	{
-		_I2CStop();
+		_I2CStop(bus);
 		return I2CERROR;
 	}
-	if(_I2CSendByte(I2Cdata) == NOACK)
+	if(_I2CSendByte(bus, I2Cdata) == NOACK)
 	{
-		_I2CStop();
+		_I2CStop(bus);
 		return I2CERROR;
 	}
 	
-	_I2CStop();
+	_I2CStop(bus);
 	return I2COK;
 }
 
 
 /**
- * 读取一个字节数据
+ * 在一次传输中连续发送头部和数据，头部一般为寄存器地址或EEPROM的字地址
  * 
+ * \param bus     : 总线对象指针
  * \param address : 从设备地址
- * \param I2Cdata : 读取到的数据存放指针
+ * \param hcount  : 头部长度，可以为0
+ * \param head    : 头部数组
+ * \param count   : 数据长度，可以为0
+ * \param I2Cdata : 需要发送的数据数组
  *
  * \return 执行结果
  * \retval I2COK    : 成功
  * \retval I2CERROR : 失败
  *
  */
-I2CResult I2CReadByte(uint8_t address, uint8_t * I2Cdata)
+I2CResult I2CBusWriteBlock(I2CBus * bus, uint8_t address, uint8_t hcount, const uint8_t head[],
+                           uint16_t count, const uint8_t I2Cdata[])
 {
-	_I2CStart();
+	uint16_t i;
+	
+	_I2CStart(bus);
 	
-	if(_I2CSendAddress(address, 1) == NOACK)
+	if(_I2CSendAddress(bus, address, 0) == NOACK)
 	{
-		_I2CStop();
+		_I2CStop(bus);
 		return I2CERROR;
 	}
-	*I2Cdata = _I2CGetByte();
+	for(i = 0; i < hcount; i++)
+	{
+		if(_I2CSendByte(bus, head[i]) == NOACK)
+		{
+			_I2CStop(bus);
+			return I2CERROR;
+		}
+	}
+	for(i = 0; i < count; i++)
+	{
+		if(_I2CSendByte(bus, I2Cdata[i]) == NOACK)
+		{
+			_I2CStop(bus);
+			return I2CERROR;
+		}
+	}
 	
-	_I2CStop();
+	_I2CStop(bus);
 	return I2COK;
 }
 
 
+/**
+ * 读取一个字节数据
+ * 
+ * \param bus     : 总线对象指针
+ * \param address : 从设备地址
+ * \param I2Cdata : 读取到的数据存放指针
+ *
+ * \return 执行结果
+ * \retval I2COK    : 成功
+ * \retval I2CERROR : 失败
+ *
+ */
+I2CResult I2CBusReadByte(I2CBus * bus, uint8_t address, uint8_t * I2Cdata)
+{
+	return I2CBusReadMultiBytes(bus, address, 1, I2Cdata);
+}
+
+
 /**
  * 读取一个寄存器中的数据，相当于先发送寄存器地址，然后从设备返回数据。
  * 发送寄存器地址为Dummy Write，之后跟随一个Start信号
  * 
+ * \param bus     : 总线对象指针
  * \param address : 从设备地址
  * \param reg     : 寄存器地址
  * \param I2Cdata : 读取到的数据存放指针
@@ -199,149 +571,756 @@ I2CResult I2CReadByte(uint8_t address, uint8_t * I2Cdata)
  * \retval I2CERROR : 失败
  *
  */
-I2CResult I2CReadReg(uint8_t address, uint8_t reg, uint8_t * I2Cdata)
+I2CResult I2CBusReadReg(I2CBus * bus, uint8_t address, uint8_t reg, uint8_t * I2Cdata)
+{
+	return I2CBusReadRegs(bus, address, reg, 1, I2Cdata);
+}
+
+
+/**
+ * 连续读取多个字节数据，除最后一个字节外每个字节后发送ACK，最后一个字节后发送NOACK
+ * 
+ * \param bus     : 总线对象指针
+ * \param address : 从设备地址
+ * \param count   : 数据长度，不能为0
+ * \param I2Cdata : 读取到的数据存放数组
+ *
+ * \return 执行结果
+ * \retval I2COK    : 成功
+ * \retval I2CERROR : 失败
+ *
+ */
+I2CResult I2CBusReadMultiBytes(I2CBus * bus, uint8_t address, uint8_t count, uint8_t I2Cdata[])
+{
+	uint8_t i;
+	
+	if(count == 0)
+		return I2CERROR;
+	
+	_I2CStart(bus);
+	
+	if(_I2CSendAddress(bus, address, 1) == NOACK)
+	{
+		_I2CStop(bus);
+		return I2CERROR;
+	}
+	/* 最后一个字节发送NOACK，通知从设备停止发送 */
+	for(i = 0; i < count; i++)
+	{
+		I2Cdata[i] = _I2CGetByte(bus, i + 1 < count ? ACK : NOACK);
+	}
+	
+	_I2CStop(bus);
+	return bus->timeout ? I2CERROR : I2COK;
+}
+
+
+/**
+ * 从指定寄存器开始连续读取多个寄存器，寄存器地址由从设备自动递增。
+ * 发送寄存器地址为Dummy Write，之后跟随一个Start信号
+ * 
+ * \param bus     : 总线对象指针
+ * \param address : 从设备地址
+ * \param reg     : 起始寄存器地址
+ * \param count   : 数据长度，不能为0
+ * \param I2Cdata : 读取到的数据存放数组
+ *
+ * \return 执行结果
+ * \retval I2COK    : 成功
+ * \retval I2CERROR : 失败
+ *
+ */
+I2CResult I2CBusReadRegs(I2CBus * bus, uint8_t address, uint8_t reg, uint8_t count, uint8_t I2Cdata[])
 {
-	_I2CStart();
-	if(_I2CSendAddress(address, 0) == NOACK)
+	uint8_t i;
+	
+	if(count == 0)
+		return I2CERROR;
+	
+	_I2CStart(bus);
+	if(_I2CSendAddress(bus, address, 0) == NOACK)
 	{
-		_I2CStop();
+		_I2CStop(bus);
 		return I2CERROR;
 	}
-	if(_I2CSendByte(reg) == NOACK)
+	if(_I2CSendByte(bus, reg) == NOACK)
 	{
-		_I2CStop();
+		_I2CStop(bus);
 		return I2CERROR;
 	}
 	
-	_I2CStart();
-	if(_I2CSendAddress(address, 1) == NOACK)
+	_I2CStart(bus);
+	if(_I2CSendAddress(bus, address, 1) == NOACK)
 	{
-		_I2CStop();
+		_I2CStop(bus);
 		return I2CERROR;
 	}
-	*I2Cdata = _I2CGetByte();
+	for(i = 0; i < count; i++)
+	{
+		I2Cdata[i] = _I2CGetByte(bus, i + 1 < count ? ACK : NOACK);
+	}
 	
-	_I2CStop();
-	return I2COK;
+	_I2CStop(bus);
+	return bus->timeout ? I2CERROR : I2COK;
 }
 
 
 /**
- * 延时函数，延时的时间为一位数据持续时间的一半
+ * 连续执行多个读写操作，操作之间使用重复Start，不发送Stop信号和等待总线空闲时间。
+ * 带I2C_OP_AUTO_INC标志的写寄存器操作，如果与上一个操作是同一从设备的写寄存器操作，
+ * 且寄存器地址连续，则直接发送数据，不再发送设备地址和寄存器地址。
+ * 从设备无应答时发送Stop信号并停止执行
+ * 
+ * \param bus   : 总线对象指针
+ * \param ops   : 操作数组，执行后每个操作的result为执行结果，未执行的操作为I2CERROR
+ * \param count : 操作个数
+ *
+ * \return 成功执行的操作个数，等于count时全部成功
+ *
  */
-static void _I2CDelay(void)
+uint8_t I2CBusBatch(I2CBus * bus, I2COp ops[], uint8_t count)
 {
-  uint16_t k;
-  for(k = 0; k < I2C_DELAY_COUNT; k++);
+	uint8_t i;
+	uint8_t started = 0;     /* 已发送Start信号，尚未发送Stop信号 */
+	uint8_t writing = 0xFF;  /* 可以合并的写寄存器操作的从设备地址，0xFF表示没有 */
+	uint8_t nextReg = 0;     /* 合并时下一个寄存器地址 */
+	
+	for(i = 0; i < count; i++)
+		ops[i].result = I2CERROR;
+	
+	for(i = 0; i < count; i++)
+	{
+		/* 能否合并由_I2CBatchOp判断，未合并时发送Start或重复Start */
+		if(!started)
+			writing = 0xFF;
+		started = 1;
+		if(_I2CBatchOp(bus, &ops[i], &writing, &nextReg) == NOACK || bus->timeout)
+		{
+			_I2CStop(bus);
+			return i;
+		}
+		ops[i].result = I2COK;
+		
+		if(ops[i].flags & I2C_OP_STOP)
+		{
+			_I2CStop(bus);
+			started = 0;
+		}
+	}
+	
+	if(started)
+		_I2CStop(bus);
+	return count;
 }
 
+
 /**
- * 发送Start信号
+ * 统计信息清零，并清除传输段记录
+ *
+ * \param bus : 总线对象指针
+ *
  */
-static void _I2CStart(void)
+void I2CBusResetStats(I2CBus * bus)
 {
-	HAL_SCL_W(0);
-	_I2CDelay();
-	HAL_SDA_W(1);
-	_I2CDelay();
-	HAL_SCL_W(1);
-	_I2CDelay();
-	HAL_SDA_W(0);
-  _I2CDelay();
+	bus->stats.trans = 0;
+	bus->stats.nacks = 0;
+	bus->stats.timeouts = 0;
+	bus->stats.polls = 0;
+#ifdef I2C_STATS
+	bus->stats.bytes = 0;
+	bus->stats.nackAddr = 0;
+	bus->stats.stretch = 0;
+	bus->stats.busy = 0;
+	bus->statsState = 0;
+	bus->statsMark = 0;
+	bus->stretchRem = 0;
+#if I2C_TRACE_SIZE > 0
+	bus->traceHead = 0;
+	bus->traceCount = 0;
+	bus->traceBytes = 0;
+	bus->traceNacks = 0;
+#endif
+#endif
+}
+
+
+#ifdef I2C_STATS
+/**
+ * 计算总线占用率
+ *
+ * \param bus : 总线对象指针
+ * \param ms  : I2CBusResetStats之后经过的时间(ms)，由调用者计时
+ *
+ * \return 占用率(%)，0~100
+ *
+ */
+uint8_t I2CBusBusyPercent(I2CBus * bus, uint32_t ms)
+{
+	uint32_t busy = bus->stats.busy;
+	uint32_t total;
+	
+	/* 经过的时间（HAL_I2C_STATS_TIME()的计数），超出32位时取最大值 */
+#if I2C_STATS_TIME_PER_MS > 1
+	if(ms > 0xFFFFFFFFUL / I2C_STATS_TIME_PER_MS)
+		total = 0xFFFFFFFFUL;
+	else
+#endif
+		total = ms * I2C_STATS_TIME_PER_MS;
+	
+	if(busy >= total)
+		return 100;
+	/* busy * 100超出32位时先缩小total，此时total大于4e7，误差可忽略 */
+	if(busy <= 0xFFFFFFFFUL / 100)
+		return (uint8_t)(busy * 100 / total);
+	return (uint8_t)(busy / (total / 100));
+}
+
+
+#if I2C_TRACE_SIZE > 0
+/**
+ * 从最早到最近依次输出传输段记录，每个记录按I2CTraceEntry的成员顺序输出7个字节，可直接发送到串口
+ *
+ * \param bus : 总线对象指针
+ * \param put : 输出一个字节的函数，如串口发送函数
+ *
+ * \return 输出的记录个数
+ *
+ */
+uint8_t I2CBusTraceDump(I2CBus * bus, void (*put)(uint8_t c))
+{
+	uint8_t i;
+	I2CTraceEntry * e;
+	
+	for(i = 0; i < bus->traceCount; i++)
+	{
+		e = &bus->trace[(uint8_t)(bus->traceHead - bus->traceCount + i) & (I2C_TRACE_SIZE - 1)];
+		put(e->addr);
+		put(e->len);
+		put(e->result);
+		put((uint8_t)(e->time >> 24));
+		put((uint8_t)(e->time >> 16));
+		put((uint8_t)(e->time >> 8));
+		put((uint8_t)e->time);
+	}
+	return bus->traceCount;
+}
+#endif
+#endif
+
+
+#ifndef I2C_NO_DEFAULT_BUS
+/** 同I2CBusSetSpeed，使用默认总线 */
+I2CResult I2CSetSpeed(I2CSpeed speed)
+{
+	return I2CBusSetSpeed(&I2CDefaultBus, speed);
+}
+
+/** 同I2CBusSCLTestOut，使用默认总线 */
+uint32_t SCLTestOut(void)
+{
+	return I2CBusSCLTestOut(&I2CDefaultBus);
+}
+
+/** 同I2CBusWriteByte，使用默认总线 */
+I2CResult I2CWriteByte(uint8_t address, uint8_t I2Cdata)
+{
+	return I2CBusWriteByte(&I2CDefaultBus, address, I2Cdata);
+}
+
+/** 同I2CBusWriteMultiBytes，使用默认总线 */
+I2CResult I2CWriteMultiBytes(uint8_t address, uint8_t count, uint8_t I2Cdata[])
+{
+	return I2CBusWriteMultiBytes(&I2CDefaultBus, address, count, I2Cdata);
+}
+
+/** 同I2CBusWriteReg，使用默认总线 */
+I2CResult I2CWriteReg(uint8_t address, uint8_t reg, uint8_t I2Cdata)
+{
+	return I2CBusWriteReg(&I2CDefaultBus, address, reg, I2Cdata);
+}
+
+/** 同I2CBusWriteBlock，使用默认总线 */
+I2CResult I2CWriteBlock(uint8_t address, uint8_t hcount, const uint8_t head[], uint16_t count, const uint8_t I2Cdata[])
+{
+	return I2CBusWriteBlock(&I2CDefaultBus, address, hcount, head, count, I2Cdata);
+}
+
+/** 同I2CBusReadByte，使用默认总线 */
+I2CResult I2CReadByte(uint8_t address, uint8_t * I2Cdata)
+{
+	return I2CBusReadByte(&I2CDefaultBus, address, I2Cdata);
+}
+
+/** 同I2CBusReadReg，使用默认总线 */
+I2CResult I2CReadReg(uint8_t address, uint8_t reg, uint8_t * I2Cdata)
+{
+	return I2CBusReadReg(&I2CDefaultBus, address, reg, I2Cdata);
+}
+
+/** 同I2CBusReadMultiBytes，使用默认总线 */
+I2CResult I2CReadMultiBytes(uint8_t address, uint8_t count, uint8_t I2Cdata[])
+{
+	return I2CBusReadMultiBytes(&I2CDefaultBus, address, count, I2Cdata);
+}
+
+/** 同I2CBusReadRegs，使用默认总线 */
+I2CResult I2CReadRegs(uint8_t address, uint8_t reg, uint8_t count, uint8_t I2Cdata[])
+{
+	return I2CBusReadRegs(&I2CDefaultBus, address, reg, count, I2Cdata);
+}
+
+/** 同I2CBusBatch，使用默认总线 */
+uint8_t I2CBatch(I2COp ops[], uint8_t count)
+{
+	return I2CBusBatch(&I2CDefaultBus, ops, count);
+}
+#endif
+
+
+/**
+ * 执行I2CBatch的一个操作，不发送Stop信号
+ *
+ * \param writing : 上一个写寄存器操作的从设备地址，执行后更新
+ * \param nextReg : 上一个写寄存器操作的下一个寄存器地址，执行后更新
+ */
+static ACK_State _I2CBatchOp(I2CBus * bus, I2COp * op, uint8_t * writing, uint8_t * nextReg)
+{
+	uint8_t i;
+	
+	if(op->type == I2C_OP_WRITE_REG)
+	{
+		/* 合并：继续发送数据，由从设备递增寄存器地址 */
+		if((op->flags & I2C_OP_AUTO_INC) && *writing == op->address && *nextReg == op->reg)
+		{
+			(*nextReg)++;
+			return _I2CSendByte(bus, op->value);
+		}
+		
+		*writing = op->address;
+		*nextReg = op->reg + 1;
+		_I2CStart(bus);
+		if(_I2CSendAddress(bus, op->address, 0) == NOACK || _I2CSendByte(bus, op->reg) == NOACK)
+			return NOACK;
+		return _I2CSendByte(bus, op->value);
+	}
+	
+	*writing = 0xFF;
+	if(op->count == 0)
+		return NOACK;
+	
+	if(op->type == I2C_OP_READ_REG)
+	{
+		_I2CStart(bus);
+		if(_I2CSendAddress(bus, op->address, 0) == NOACK || _I2CSendByte(bus, op->reg) == NOACK)
+			return NOACK;
+	}
+	_I2CStart(bus);
+	if(_I2CSendAddress(bus, op->address, 1) == NOACK)
+		return NOACK;
+	for(i = 0; i < op->count; i++)
+	{
+		op->data[i] = _I2CGetByte(bus, i + 1 < op->count ? ACK : NOACK);
+	}
+	return ACK;
+}
+
+
+/**
+ * 延时函数，每位数据的SCL低电平延时2次bus->low，高电平延时1次bus->high
+ */
+#ifdef I2C_DELAY_TIMER
+static void _I2CDelay(I2CBus * bus, uint16_t count)
+{
+	uint16_t next = bus->next + count;
+	
+	/* 从上一次延时结束起计时，端口操作的时间也计算在内；
+	   已超过结束时刻（如被中断打断）时不再等待，从当前时刻重新计时 */
+	if((int16_t)(HAL_I2C_TICKS() - next) >= 0)
+	{
+		I2C_DELAY_START(bus);
+		return;
+	}
+	while((int16_t)(HAL_I2C_TICKS() - next) < 0);
+	bus->next = next;
+}
+#else
+static void _I2CDelay(I2CBus * bus, uint16_t count)
+{
+	/* volatile避免循环被编译器优化掉 */
+	volatile uint16_t k;
+	(void)bus;
+	for(k = 0; k < count; k++);
+}
+#endif
+
+/**
+ * 释放SCL并等待其变为高电平。从设备时钟延展时继续等待，
+ * 超过I2C_STRETCH_TIMEOUT后置位bus->timeout，本次传输之后不再等待
+ */
+static void _I2CSclHigh(I2CBus * bus)
+{
+	uint16_t t0, t1;
+	uint32_t wait = 0;
+	
+	I2C_SCL_W(bus, 1);
+	if(I2C_SCL_R(bus) == 0)
+	{
+		t0 = HAL_I2C_TICKS();
+		while(I2C_SCL_R(bus) == 0 && !bus->timeout)
+		{
+			t1 = HAL_I2C_TICKS();
+			wait += (uint16_t)(t1 - t0);
+			t0 = t1;
+			if(wait > I2C_STRETCH_TICKS)
+			{
+				bus->timeout = 1;
+				bus->stats.timeouts++;
+			}
+		}
+		I2C_STATS_STRETCH(bus, wait);
+	}
+	/* 高电平时间从SCL实际变为高电平时开始计算 */
+	I2C_DELAY_START(bus);
+}
+
+/**
+ * 输出I2C_TEST_PERIODS个时钟信号，返回所用的计数值
+ */
+static uint32_t _I2CClockOut(I2CBus * bus)
+{
+	uint8_t i;
+	uint16_t t0, t1;
+	uint32_t ticks = 0;
+	
+	bus->timeout = 0;
+	I2C_DELAY_START(bus);
+	t0 = HAL_I2C_TICKS();
+	for(i = 0; i < I2C_TEST_PERIODS; i++)
+	{
+		I2C_SCL_W(bus, 0);
+		_I2CDelay(bus, bus->low);
+		_I2CDelay(bus, bus->low);
+		_I2CSclHigh(bus);
+		_I2CDelay(bus, bus->high);
+		/* 16位计数器，按周期累加避免回绕 */
+		t1 = HAL_I2C_TICKS();
+		ticks += (uint16_t)(t1 - t0);
+		t0 = t1;
+	}
+	return ticks;
+}
+
+/**
+ * 发送Start信号，也用于重复Start
+ */
+static void _I2CStart(I2CBus * bus)
+{
+	I2C_STATS_START(bus);
+	bus->timeout = 0;
+	I2C_DELAY_START(bus);
+	I2C_SCL_W(bus, 0);
+	_I2CDelay(bus, bus->low);
+	I2C_SDA_W(bus, 1);
+	_I2CDelay(bus, bus->low);
+	_I2CSclHigh(bus);
+	/* 重复Start的建立时间与SCL低电平时间相同，保持时间与高电平时间相同 */
+	_I2CDelay(bus, bus->low);
+	_I2CDelay(bus, bus->low);
+	I2C_SDA_W(bus, 0);
+	_I2CDelay(bus, bus->high);
 }
 
 /**
  * 发送Stop信号
  */
-static void _I2CStop(void)
+static void _I2CStop(I2CBus * bus)
 {
-	HAL_SCL_W(0);
-	_I2CDelay();
-	HAL_SDA_W(0);
-	_I2CDelay();
-	HAL_SCL_W(1);
-	_I2CDelay();
-	HAL_SDA_W(1);
-	_I2CDelay();
+	I2C_SCL_W(bus, 0);
+	_I2CDelay(bus, bus->low);
+	I2C_SDA_W(bus, 0);
+	_I2CDelay(bus, bus->low);
+	_I2CSclHigh(bus);
+	_I2CDelay(bus, bus->high);
+	I2C_SDA_W(bus, 1);
+	/* 到下一个Start之间的总线空闲时间 */
+	_I2CDelay(bus, bus->low);
+	_I2CDelay(bus, bus->low);
+	bus->stats.trans++;
+	I2C_STATS_STOP(bus);
 }
 
 /**
  * 发送从设备地址
  */
-static ACK_State _I2CSendAddress(uint8_t address, uint8_t wr)
+static ACK_State _I2CSendAddress(I2CBus * bus, uint8_t address, uint8_t wr)
 {
-	return _I2CSendByte((address << 1) + (wr & 0x01));
+	uint8_t addr = (address << 1) + (wr & 0x01);
+	ACK_State ack = _I2CSendByte(bus, addr);
+	
+	/* ACK轮询中的地址无应答计入polls，不计入nacks */
+	if(ack == NOACK && bus->polling && !bus->timeout)
+	{
+		bus->stats.nacks--;
+		bus->stats.polls++;
+	}
+	I2C_STATS_ADDRESS(bus, addr, ack);
+	return ack;
 }
 
+#ifndef I2C_UNROLL
 /**
- * 发送一个字节数据
+ * 发送一个字节数据，从设备时钟延展超时时返回NOACK。时序变量读入局部变量
  */
-static ACK_State _I2CSendByte(uint8_t databyte)
+static ACK_State _I2CSendByte(I2CBus * bus, uint8_t databyte)
 {
 	uint8_t i;
-	uint16_t cnt;
+	uint16_t low = bus->low;
+	uint16_t high = bus->high;
+#ifdef I2C_LOCAL_NEXT
+	uint16_t next = bus->next;
+#endif
 	
 	/* Write 8 bit data */
 	for(i = 8; i > 0; i--)
 	{
-		HAL_SCL_W(0);
-		_I2CDelay();
-		HAL_SDA_W(databyte >> (i - 1) & 0x01);
-		_I2CDelay();
-		HAL_SCL_W(1);
-		_I2CDelay();
-		_I2CDelay();
+		I2C_SCL_W(bus, 0);
+		I2C_DELAY(bus, low);
+		I2C_SDA_W(bus, databyte >> (i - 1) & 0x01);
+		I2C_DELAY(bus, low);
+		I2C_SCL_HIGH(bus);
+		I2C_DELAY(bus, high);
 	}
 	
-	/* Read ACK */
-	cnt = 0;
-	HAL_SCL_W(0);
-	HAL_SDA_W(1);
-	_I2CDelay();
-	_I2CDelay();
-	HAL_SCL_W(1);
-	while(HAL_SDA_R == 1)
+	/* Read ACK，从设备在SCL低电平期间给出ACK，高电平结束前读取 */
+	I2C_SCL_W(bus, 0);
+	I2C_SDA_W(bus, 1);
+	I2C_DELAY(bus, low);
+	I2C_DELAY(bus, low);
+	I2C_SCL_HIGH(bus);
+	I2C_DELAY(bus, high);
+#ifdef I2C_LOCAL_NEXT
+	bus->next = next;
+#endif
+	I2C_STATS_BYTE(bus);
+	if(bus->timeout)
+		return NOACK;
+	if(I2C_SDA_R(bus) == 1)
 	{
-		if(cnt++ > I2C_DELAY_COUNT * 3)
-			return NOACK;
+		bus->stats.nacks++;
+		return NOACK;
 	}
-	_I2CDelay();
-	_I2CDelay();
 	return ACK;
 }
 
 /**
- * 读取从设备返回的一个字节数据
+ * 读取从设备返回的一个字节数据，从设备时钟延展超时时置位bus->timeout
+ *
+ * \param ack : 读取后发送ACK（继续读取）或NOACK（最后一个字节）
  */
-static uint8_t _I2CGetByte(void)
+static uint8_t _I2CGetByte(I2CBus * bus, ACK_State ack)
 {
 	uint8_t i;
 	uint8_t tmp, res = 0;
-	uint16_t cnt;
+	uint16_t low = bus->low;
+	uint16_t high = bus->high;
+#ifdef I2C_LOCAL_NEXT
+	uint16_t next = bus->next;
+#endif
 	
-	/* Read 8 bit data */
-	HAL_SDA_W(1);
+	/* Read 8 bit data，SCL为低时再释放SDA，避免上一字节的ACK后产生Stop信号 */
+	I2C_SCL_W(bus, 0);
+	I2C_SDA_W(bus, 1);
 	for(i = 8; i > 0; i--)
 	{
-		HAL_SCL_W(0);
-		_I2CDelay();
-		_I2CDelay();
-		HAL_SCL_W(1);
-		_I2CDelay();
-		tmp = HAL_SDA_R;
+		I2C_SCL_W(bus, 0);
+		I2C_DELAY(bus, low);
+		I2C_DELAY(bus, low);
+		I2C_SCL_HIGH(bus);
+		I2C_DELAY(bus, high);
+		tmp = I2C_SDA_R(bus);
 		res += ((tmp & 0x01) << (i - 1));
-		_I2CDelay();
 	}
 	
-	/* Send NOACK */
+	/* Send ACK / NOACK */
+	I2C_SCL_W(bus, 0);
+	I2C_DELAY(bus, low);
+	I2C_SDA_W(bus, ack == ACK ? 0 : 1);
+	I2C_DELAY(bus, low);
+	I2C_SCL_HIGH(bus);
+	I2C_DELAY(bus, high);
+#ifdef I2C_LOCAL_NEXT
+	bus->next = next;
+#endif
+	I2C_STATS_BYTE(bus);
+	
+	return res;
+}
+#else
+/**
+ * 发送一个字节数据，从设备时钟延展超时时返回NOACK。按位展开，延时不调用函数
+ */
+static ACK_State _I2CSendByte(I2CBus * bus, uint8_t databyte)
+{
+	uint16_t low = bus->low;
+	uint16_t high = bus->high;
+#ifdef I2C_LOCAL_NEXT
+	uint16_t next = bus->next;
+#endif
+	
+	_I2CBits = databyte;
+	I2C_SEND_BIT(0x80);
+	I2C_SEND_BIT(0x40);
+	I2C_SEND_BIT(0x20);
+	I2C_SEND_BIT(0x10);
+	I2C_SEND_BIT(0x08);
+	I2C_SEND_BIT(0x04);
+	I2C_SEND_BIT(0x02);
+	I2C_SEND_BIT(0x01);
+	
+	/* Read ACK */
+	HAL_SCL_W(0);
+	HAL_SDA_W(1);
+	I2C_DELAY(bus, low);
+	I2C_DELAY(bus, low);
+	I2C_SCL_HIGH(bus);
+	I2C_DELAY(bus, high);
+#ifdef I2C_LOCAL_NEXT
+	bus->next = next;
+#endif
+	I2C_STATS_BYTE(bus);
+	if(bus->timeout)
+		return NOACK;
+	if(HAL_SDA_R)
+	{
+		bus->stats.nacks++;
+		return NOACK;
+	}
+	return ACK;
+}
+
+/**
+ * 读取从设备返回的一个字节数据，从设备时钟延展超时时置位bus->timeout。按位展开，延时不调用函数
+ *
+ * \param ack : 读取后发送ACK（继续读取）或NOACK（最后一个字节）
+ */
+static uint8_t _I2CGetByte(I2CBus * bus, ACK_State ack)
+{
+	uint16_t low = bus->low;
+	uint16_t high = bus->high;
+#ifdef I2C_LOCAL_NEXT
+	uint16_t next = bus->next;
+#endif
+	
+	/* SCL为低时再释放SDA */
 	HAL_SCL_W(0);
-	_I2CDelay();
 	HAL_SDA_W(1);
-	_I2CDelay();
-	HAL_SCL_W(1);
-	_I2CDelay();
-	_I2CDelay();
+	_I2CBits = 0;
+	I2C_GET_BIT(0x80);
+	I2C_GET_BIT(0x40);
+	I2C_GET_BIT(0x20);
+	I2C_GET_BIT(0x10);
+	I2C_GET_BIT(0x08);
+	I2C_GET_BIT(0x04);
+	I2C_GET_BIT(0x02);
+	I2C_GET_BIT(0x01);
 	
-	return res;
+	/* Send ACK / NOACK */
+	HAL_SCL_W(0);
+	I2C_DELAY(bus, low);
+	HAL_SDA_W(ack == ACK ? 0 : 1);
+	I2C_DELAY(bus, low);
+	I2C_SCL_HIGH(bus);
+	I2C_DELAY(bus, high);
+#ifdef I2C_LOCAL_NEXT
+	bus->next = next;
+#endif
+	I2C_STATS_BYTE(bus);
+	
+	return _I2CBits;
+}
+#endif
+
+#ifdef I2C_STATS
+/**
+ * Start或重复Start：结束上一个传输段记录，Start时记录开始时间
+ */
+static void _I2CStatsStart(I2CBus * bus)
+{
+	if(!(bus->statsState & I2C_STATS_IN_TRANS))
+		bus->statsMark = HAL_I2C_STATS_TIME();
+#if I2C_TRACE_SIZE > 0
+	if(bus->statsState & I2C_STATS_IN_TRACE)
+		_I2CTraceClose(bus);
+#endif
+	bus->statsState = I2C_STATS_IN_TRANS;
+}
+
+/**
+ * Stop结束：结束传输段记录，累计总线占用时间
+ */
+static void _I2CStatsStop(I2CBus * bus)
+{
+	bus->stats.busy += HAL_I2C_STATS_TIME() - bus->statsMark;
+#if I2C_TRACE_SIZE > 0
+	if(bus->statsState & I2C_STATS_IN_TRACE)
+		_I2CTraceClose(bus);
+#endif
+	bus->statsState = 0;
+}
+
+/**
+ * 累计时钟延展时间，wait为计数值，换算为HAL_I2C_STATS_TIME()的计数，余数留到下一次
+ */
+static void _I2CStatsStretch(I2CBus * bus, uint32_t wait)
+{
+	wait += bus->stretchRem;
+	bus->stats.stretch += wait / I2C_STATS_TIME_TICKS;
+	bus->stretchRem = (uint16_t)(wait % I2C_STATS_TIME_TICKS);
+}
+
+/**
+ * 地址字节已发送：统计地址阶段的无应答，开始传输段记录
+ */
+static void _I2CStatsAddress(I2CBus * bus, uint8_t addr, ACK_State ack)
+{
+#if I2C_TRACE_SIZE > 0
+	I2CTraceEntry * e = &bus->trace[bus->traceHead];
+#endif
+	
+	/* ACK轮询中的地址无应答已计入polls，不记录传输段 */
+	if(ack == NOACK && bus->polling && !bus->timeout)
+		return;
+#if I2C_TRACE_SIZE > 0
+	e->addr = addr;
+	e->result = ack == ACK ? I2C_TRACE_OK : I2C_TRACE_NACK_ADDR;
+	e->time = HAL_I2C_STATS_TIME();
+	bus->traceBytes = (uint16_t)bus->stats.bytes;
+	bus->traceNacks = (uint8_t)bus->stats.nacks;
+	bus->statsState |= I2C_STATS_IN_TRACE;
+#else
+	(void)addr;
+#endif
+	if(ack == NOACK && !bus->timeout)
+		bus->stats.nackAddr++;
+}
+
+#if I2C_TRACE_SIZE > 0
+/**
+ * 结束当前传输段记录，确定字节数和结果
+ */
+static void _I2CTraceClose(I2CBus * bus)
+{
+	I2CTraceEntry * e = &bus->trace[bus->traceHead];
+	uint16_t len = (uint16_t)bus->stats.bytes - bus->traceBytes;
+	
+	e->len = len > 0xFF ? 0xFF : (uint8_t)len;
+	if(bus->timeout)
+		e->result = I2C_TRACE_TIMEOUT;
+	else if(e->result == I2C_TRACE_OK && (uint8_t)bus->stats.nacks != bus->traceNacks)
+		e->result = I2C_TRACE_NACK_DATA;
+	bus->traceHead = (bus->traceHead + 1) & (I2C_TRACE_SIZE - 1);
+	if(bus->traceCount < I2C_TRACE_SIZE)
+		bus->traceCount++;
 }
- 
\ No newline at end of file
+#endif
+#endif
@@ -10,13 +10,31 @@
  * \note 某些低端MCU（如51）没有硬件I2C模块，
  *       故需要使用GPIO实现I2C协议
  *
- * \todo 目前未实现连续读多个字节数据
- *
  * 修改记录：\n
  *
  * 2015-09-27 :\n
  *   -修改注释格式使其可以使用Doxygen\n
  *   -为内部函数增加static限定\n
+ *
+ * 2026-10-18 :\n
+ *   -增加I2CReadMultiBytes、I2CReadRegs，连续读多个字节\n
+ *   -I2CReadByte、I2CReadReg改为调用上述函数\n
+ *   -延时改为按硬件计数器计时，增加I2CSetSpeed选择总线速度并自动校准\n
+ *   -SCLTestOut返回实际的SCL频率\n
+ *   -SCL变为高电平后回读，支持从设备时钟延展，超时返回I2CERROR\n
+ *   -SCL高电平时间取规范的最小值，读取ACK不再循环等待\n
+ *   -增加I2CBatch，连续执行多个读写操作，之间使用重复Start\n
+ *   -增加总线对象I2CBus（引脚操作、时序、统计信息），增加以I2CBus为参数的I2CBus*系列函数，支持多个总线\n
+ *   -原有函数改为使用默认总线I2CDefaultBus\n
+ *   -增加I2C_SINGLE_BUS、I2C_NO_DEFAULT_BUS宏定义\n
+ *   -增加I2C_HOST编译选项，支持在Linux主机上仿真运行\n
+ *   -增加I2C_UNROLL编译选项，单总线时按位展开发送和接收，增加I2C_BDATA宏定义\n
+ *   -增加I2CWriteBlock，连续发送头部和数据两段，数据不需要复制到同一数组\n
+ *   -增加I2C_STATS编译选项：字节数、分阶段的无应答次数、时钟延展时间、总线占用时间，及最近传输的记录\n
+ *   -增加I2CBusResetStats、I2CBusBusyPercent、I2CBusTraceDump\n
+ *   -示例HAL_I2C_TICKS()改为高-低-高读取，避免低字节进位时读到错误的值\n
+ *   -I2CBus增加polling，ACK轮询中的地址无应答计入stats.polls，不计入nacks，不记录传输段\n
+ *   -I2C_STATS的总线占用和时钟延展时间改为HAL_I2C_STATS_TIME()的计数，只在Start、Stop时读取时间\n
  * 
  */
  
@@ -24,11 +42,45 @@
 #define GPIO_I2C_H
 
 /*--------------------此部分需要修改--------------------*/
+/* 编译选项开关，定义后在Linux主机上仿真运行，见Host/I2C_Host.h，其中已定义下面的HAL宏 */
+//#define I2C_HOST
+
 /* 如未定义uint8_t等基本数据类型，需要先定义 */
+#ifndef I2C_HOST
 #include "TypeDef.h"
+#endif
+
+/* 编译选项开关，定义后只支持一个总线：引脚操作直接使用下面的HAL宏定义，
+   不经过I2CBusOps函数指针，I2CBus*函数的bus参数只用于时序和统计信息 */
+//#define I2C_SINGLE_BUS
+
+/* 编译选项开关，需同时定义I2C_SINGLE_BUS。定义后发送和接收字节时8位逐一展开，
+   延时和SCL回读直接写在展开的代码中，不调用函数，时序变量暂存在局部变量中；
+   代码量增加，适用于函数调用和指针访问开销较大的MCU（如8051）。
+   各平台bus->low、bus->high为0时的最高SCL频率（按生成代码的指令周期估算，以SCLTestOut实测为准）：
+     平台                       延时方式    未定义I2C_UNROLL    定义I2C_UNROLL
+     STC15 1T @11.0592MHz       计数器      约28kHz             约110kHz
+     STC15 1T @11.0592MHz       循环        约75kHz             约220kHz
+     8051 12T @12MHz            计数器      约3kHz              约15kHz
+     8051 12T @12MHz            循环        约7kHz              约20kHz
+   达不到所选速度时I2CSetSpeed返回I2CERROR，并以能达到的最高速度运行；
+   默认配置在STC15上达不到100kHz，需要100kHz时定义I2C_SINGLE_BUS和I2C_UNROLL */
+//#define I2C_UNROLL
+
+/* 定义I2C_UNROLL时暂存收发字节的变量的存储类型。Keil C51可定义为bdata（位寻址区），
+   按常量掩码测试和设置各位时可使用位寻址指令；其他编译器保持为空 */
+#define I2C_BDATA
+
+/* 编译选项开关，定义后不提供默认总线I2CDefaultBus及原有的I2CWrite*、I2CRead*等函数，
+   此时不需要下面的HAL_SCL_W等宏定义，各总线的引脚操作由I2CBusOps提供 */
+//#define I2C_NO_DEFAULT_BUS
 
 /* HAL层提供的GPIO底层实现宏定义，此处以STC15W1K16S为例，需要根据实际情况修改 */
 
+#ifdef I2C_HOST
+/* Linux主机仿真环境 */
+#include "I2C_Host.h"
+#else
 /* HAL头文件 */
 #include "STC15F2K60S2.h"
  
@@ -43,7 +95,8 @@
 #define HAL_SDA_W(STATE) (P34=STATE)
 
 /**
- * 读取时钟信号(SCL)当前电位
+ * 读取时钟信号(SCL)当前电位。SCL需为开漏输出（或准双向口）并接上拉电阻，
+ * 释放SCL后回读实际电平，从设备拉低SCL（时钟延展）时等待
  */
 #define HAL_SCL_R (P33)
 
@@ -53,10 +106,69 @@
 #define HAL_SDA_R (P34)
 
 /**
- * 延时时间宏定义，值越大则总线速度越慢
+ * 读取自由运行的16位递增计数器，用于延时、速度校准和SCLTestOut测量，计满后从0继续计数。
+ * 此处以STC15的定时器0为例（1T、16位自动重装模式、重装值为0），使用前需初始化：
+ *   AUXR |= 0x80; TMOD &= 0xF0; TL0 = 0; TH0 = 0; TR0 = 1;
+ * 8位MCU分两次读取高低字节，读取之间低字节进位会得到相差256的值：
+ * 先读高字节、再读低字节、再读高字节，高字节变化时重新读取（此时低字节刚回绕，不会再次进位）。
+ * 不可在中断中与主程序同时使用
+ */
+#define HAL_I2C_TICKS() (I2CTickHigh = TH0, I2CTickLow = TL0, \
+	TH0 == I2CTickHigh ? (((uint16_t)I2CTickHigh << 8) | I2CTickLow) : (((uint16_t)TH0 << 8) | TL0))
+
+/**
+ * HAL_I2C_TICKS()使用的暂存变量，在GPIO_I2C.c中定义；HAL_I2C_TICKS()不需要时删除此定义
+ */
+#define HAL_I2C_TICKS_VARS uint8_t I2CTickHigh, I2CTickLow
+extern uint8_t I2CTickHigh, I2CTickLow;
+
+/**
+ * 计数器的计数频率(Hz)
+ */
+#define HAL_I2C_TICK_HZ 11059200UL
+
+/**
+ * 32位递增时间，定义I2C_STATS时使用：总线占用和时钟延展的累计时间以此为单位，
+ * 并作为传输段记录的时间戳。每个Start（不含重复Start）、Stop和地址字节各读取一次。
+ * HAL_I2C_TICKS()约5.9ms回绕一次，不能用于计量较长的传输或记录间隔。
+ * 此处以定时器中断中递增的毫秒计数SysMs为例，8位MCU上读取时需关闭该中断
+ */
+#define HAL_I2C_STATS_TIME() (SysMs)
+extern volatile uint32_t SysMs;
+
+/**
+ * HAL_I2C_STATS_TIME()的计数频率(Hz)，为1000的整数倍，且不超过HAL_I2C_TICK_HZ
+ */
+#define HAL_I2C_STATS_TIME_HZ 1000UL
+#endif
+
+/**
+ * 定义时按计数器延时，总线速度与编译器和优化等级无关；
+ * 不定义时使用循环延时，循环次数由I2CSetSpeed根据计数器的测量结果计算，
+ * 适用于读取计数器较慢、按计数器延时达不到所需速度的MCU
+ */
+#define I2C_DELAY_TIMER
+
+/**
+ * 循环延时时，调用I2CSetSpeed之前SCL低电平一半时间的循环次数，值越大则总线速度越慢
  */
 #define I2C_DELAY_COUNT 45
 
+/**
+ * 从设备时钟延展（拉低SCL）的最长等待时间(us)，超时后本次传输返回I2CERROR
+ */
+#define I2C_STRETCH_TIMEOUT 1000
+
+/* 编译选项开关，定义后统计字节数、地址阶段的无应答次数、时钟延展时间和总线占用时间，
+   并在I2CBus中记录最近的传输段（Start或重复Start到下一个Start或Stop）；
+   每个字节增加一次加1，每个Start、Stop、地址字节增加一次函数调用。不定义时没有额外开销 */
+//#define I2C_STATS
+
+/**
+ * 定义I2C_STATS时每个总线记录的最近传输段个数，为2的整数次幂且不超过128，为0时不记录
+ */
+#define I2C_TRACE_SIZE 16
+
 /*--------------------此部分需要修改--------------------*/
 
 /** 返回结果枚举定义 */
@@ -66,32 +178,169 @@ typedef enum
 	I2CERROR  /**< 错误 */
 } I2CResult;
 
+/** 总线速度枚举定义 */
+typedef enum
+{
+	I2C_SPEED_100K,  /**< 标准模式，100kHz */
+	I2C_SPEED_400K,  /**< 快速模式，400kHz */
+	I2C_SPEED_1M     /**< 快速模式+，1MHz */
+} I2CSpeed;
+
+/** 总线的引脚操作，hw为I2CBus中的hw */
+typedef struct
+{
+	void (*SclWrite)(void * hw, uint8_t state);  /**< 指定SCL电平，1为释放 */
+	void (*SdaWrite)(void * hw, uint8_t state);  /**< 指定SDA电平，1为释放 */
+	uint8_t (*SclRead)(void * hw);               /**< 读取SCL当前电平 */
+	uint8_t (*SdaRead)(void * hw);               /**< 读取SDA当前电平 */
+} I2CBusOps;
+
+/** 总线统计信息 */
+typedef struct
+{
+	uint32_t trans;     /**< 传输次数（Stop信号个数） */
+	uint32_t nacks;     /**< 从设备无应答次数 */
+	uint32_t timeouts;  /**< 时钟延展超时次数 */
+	uint32_t polls;     /**< ACK轮询（I2CBus的polling为1）中地址无应答的次数，不计入nacks */
+#ifdef I2C_STATS
+	uint32_t bytes;     /**< 发送和接收的字节数，包括地址字节 */
+	uint32_t nackAddr;  /**< 地址阶段的无应答次数，数据阶段为nacks - nackAddr */
+	uint32_t stretch;   /**< 时钟延展的总时间，单位为HAL_I2C_STATS_TIME()的计数 */
+	uint32_t busy;      /**< 总线占用（Start到Stop结束）的总时间，单位为HAL_I2C_STATS_TIME()的计数。
+	                         单次传输短于一个计数时按是否跨过计数边界计0或1，多次传输平均后准确 */
+#endif
+} I2CBusStats;
+
+#if defined(I2C_STATS) && I2C_TRACE_SIZE > 0
+/** 传输段记录的结果 */
+#define I2C_TRACE_OK        0  /**< 成功 */
+#define I2C_TRACE_NACK_ADDR 1  /**< 地址无应答 */
+#define I2C_TRACE_NACK_DATA 2  /**< 数据无应答 */
+#define I2C_TRACE_TIMEOUT   3  /**< 时钟延展超时 */
+
+/** 传输段记录，I2CBusTraceDump按成员顺序输出7个字节，time高字节在前 */
+typedef struct
+{
+	uint8_t addr;       /**< 地址字节，7位地址 << 1 | 读写位（1为读） */
+	uint8_t len;        /**< 地址之后的字节数，超过255时为255 */
+	uint8_t result;     /**< 结果，I2C_TRACE_OK等 */
+	uint32_t time;      /**< 地址字节结束时的HAL_I2C_STATS_TIME() */
+} I2CTraceEntry;
+#endif
+
+/** 总线对象 */
+typedef struct I2CBus_t
+{
+	const I2CBusOps * ops;  /**< 引脚操作，定义I2C_SINGLE_BUS时不使用 */
+	void * hw;              /**< 引脚操作使用的参数，如引脚编号 */
+	uint16_t low;           /**< SCL低电平时间的一半，计数值或循环次数 */
+	uint16_t high;          /**< SCL高电平时间，计数值或循环次数 */
+	uint16_t next;          /**< 按计数器延时时上一次延时的结束时刻 */
+	uint8_t timeout;        /**< 本次传输中从设备时钟延展超时 */
+	uint8_t polling;        /**< 为1时正在ACK轮询（如等待EEPROM写周期），地址无应答计入stats.polls，不记录传输段 */
+	I2CBusStats stats;      /**< 统计信息 */
+#ifdef I2C_STATS
+	uint8_t statsState;     /**< 内部使用，是否在传输中、传输段记录中 */
+	uint32_t statsMark;     /**< 内部使用，Start时的HAL_I2C_STATS_TIME() */
+	uint16_t stretchRem;    /**< 内部使用，时钟延展时间不足一个HAL_I2C_STATS_TIME()计数的部分（计数值） */
+#if I2C_TRACE_SIZE > 0
+	uint8_t traceHead;      /**< 下一个记录的位置 */
+	uint8_t traceCount;     /**< 记录个数，最多I2C_TRACE_SIZE */
+	uint16_t traceBytes;    /**< 内部使用，当前传输段开始时stats.bytes的低16位 */
+	uint8_t traceNacks;     /**< 内部使用，当前传输段开始时stats.nacks的低8位 */
+	I2CTraceEntry trace[I2C_TRACE_SIZE];  /**< 最近的传输段，环形缓冲 */
+#endif
+#endif
+} I2CBus;
+
+/** I2CBatch的操作类型枚举定义 */
+typedef enum
+{
+	I2C_OP_WRITE_REG,  /**< 写寄存器，向reg写入value */
+	I2C_OP_READ_REG,   /**< 从reg开始读取count个寄存器到data */
+	I2C_OP_READ        /**< 不发送寄存器地址，直接读取count个字节到data */
+} I2COpType;
+
+/** 操作后发送Stop信号，如EEPROM在Stop信号后才开始写入 */
+#define I2C_OP_STOP     0x01
+/** 寄存器地址连续时与上一个写寄存器操作合并，从设备需支持寄存器地址自动递增 */
+#define I2C_OP_AUTO_INC 0x02
+
+/** I2CBatch的操作 */
+typedef struct
+{
+	uint8_t type;       /**< 操作类型，见I2COpType */
+	uint8_t flags;      /**< I2C_OP_STOP、I2C_OP_AUTO_INC的组合 */
+	uint8_t address;    /**< 从设备地址 */
+	uint8_t reg;        /**< 寄存器地址 */
+	uint8_t value;      /**< 写入的数据 */
+	uint8_t count;      /**< 读取的字节数，不能为0 */
+	uint8_t * data;     /**< 读取结果存放数组 */
+	I2CResult result;   /**< 执行结果 */
+} I2COp;
+
+
+/**
+ * 初始化总线对象，速度为100kHz（循环延时时为I2C_DELAY_COUNT次循环），统计信息清零
+ *
+ * \param bus : 总线对象指针
+ * \param ops : 引脚操作，定义I2C_SINGLE_BUS时可以为空
+ * \param hw  : 引脚操作使用的参数
+ *
+ */
+void I2CBusInit(I2CBus * bus, const I2CBusOps * ops, void * hw);
+
+
+/**
+ * 设置总线速度，同时测量实际的时钟周期进行校准，上电初始化时调用一次即可。
+ * SCL高电平时间取规范的最小值，其余时间为低电平；从设备时钟延展时总线相应变慢。
+ * 校准时在SCL上输出几十个时钟信号，SDA保持高电平，不会产生Start信号
+ * 
+ * \param bus   : 总线对象指针
+ * \param speed : 总线速度
+ *
+ * \return 执行结果
+ * \retval I2COK    : 成功
+ * \retval I2CERROR : MCU速度不足，达不到指定速度，此时以能达到的最高速度运行
+ *
+ * \note 能达到的最高速度见I2C_UNROLL处的表。默认配置（多总线、计数器延时、未定义I2C_UNROLL）
+ * 在STC15 1T @11.0592MHz上约28kHz，I2C_SPEED_100K即返回I2CERROR；
+ * 需要100kHz时定义I2C_SINGLE_BUS和I2C_UNROLL，或使用更快的MCU
+ *
+ */
+I2CResult I2CBusSetSpeed(I2CBus * bus, I2CSpeed speed);
+
 
 /**
- * 持续输出时钟信号，方便示波器观察目前的总线速度
+ * 输出16个时钟信号并测量实际的SCL频率，可循环调用以便示波器观察
+ *
+ * \param bus : 总线对象指针
+ *
+ * \return SCL频率(Hz)
  *
  */
-void SCLTestOut();
+uint32_t I2CBusSCLTestOut(I2CBus * bus);
 
 
-/*
 /**
  * 发送一个字节数据
  * 
- * \param address: 从设备地址
- * \param I2Cdata: 需要发送的数据
+ * \param bus     : 总线对象指针
+ * \param address : 从设备地址
+ * \param I2Cdata : 需要发送的数据
  *
  * \return 执行结果
  * \retval I2COK    : 成功
  * \retval I2CERROR : 失败
  *
  */
-I2CResult I2CWriteByte(uint8_t address, uint8_t I2Cdata);
+I2CResult I2CBusWriteByte(I2CBus * bus, uint8_t address, uint8_t I2Cdata);
 	
 	
 /**
  * 发送多个字节数据
  * 
+ * \param bus     : 总线对象指针
  * \param address : 从设备地址
  * \param count   : 数据长度
  * \param I2Cdata : 需要发送的数据数组
@@ -101,12 +350,13 @@ I2CResult I2CWriteByte(uint8_t address, uint8_t I2Cdata);
  * \retval I2CERROR : 失败
  *
  */
-I2CResult I2CWriteMultiBytes(uint8_t address, uint8_t count, uint8_t I2Cdata[]);
+I2CResult I2CBusWriteMultiBytes(I2CBus * bus, uint8_t address, uint8_t count, uint8_t I2Cdata[]);
 
 
 /**
  * 写寄存器，相当于先发送寄存器地址，再发送数据
  * 
+ * \param bus     : 总线对象指针
  * \param address : 从设备地址
  * \param reg     : 寄存器地址
  * \param I2Cdata : 需要发送的数据
@@ -116,12 +366,32 @@ I2CResult I2CWriteMultiBytes(uint8_t address, uint8_t count, uint8_t I2Cdata[]);
  * \retval I2CERROR : 失败
  *
  */
-I2CResult I2CWriteReg(uint8_t address, uint8_t reg, uint8_t I2Cdata);
+I2CResult I2CBusWriteReg(I2CBus * bus, uint8_t address, uint8_t reg, uint8_t I2Cdata);
+
+
+/**
+ * 在一次传输中连续发送头部和数据，头部一般为寄存器地址或EEPROM的字地址
+ * 
+ * \param bus     : 总线对象指针
+ * \param address : 从设备地址
+ * \param hcount  : 头部长度，可以为0
+ * \param head    : 头部数组
+ * \param count   : 数据长度，可以为0
+ * \param I2Cdata : 需要发送的数据数组
+ *
+ * \return 执行结果
+ * \retval I2COK    : 成功
+ * \retval I2CERROR : 失败
+ *
+ */
+I2CResult I2CBusWriteBlock(I2CBus * bus, uint8_t address, uint8_t hcount, const uint8_t head[],
+                           uint16_t count, const uint8_t I2Cdata[]);
 
 
 /**
  * 读取一个字节数据
  * 
+ * \param bus     : 总线对象指针
  * \param address : 从设备地址
  * \param I2Cdata : 读取到的数据存放指针
  *
@@ -130,13 +400,14 @@ I2CResult I2CWriteReg(uint8_t address, uint8_t reg, uint8_t I2Cdata);
  * \retval I2CERROR : 失败
  *
  */
-I2CResult I2CReadByte(uint8_t address, uint8_t * I2Cdata);
+I2CResult I2CBusReadByte(I2CBus * bus, uint8_t address, uint8_t * I2Cdata);
 
 
 /**
  * 读取一个寄存器中的数据，相当于先发送寄存器地址，然后从设备返回数据。
  * 发送寄存器地址为Dummy Write，之后跟随一个Start信号
  * 
+ * \param bus     : 总线对象指针
  * \param address : 从设备地址
  * \param reg     : 寄存器地址
  * \param I2Cdata : 读取到的数据存放指针
@@ -146,6 +417,130 @@ I2CResult I2CReadByte(uint8_t address, uint8_t * I2Cdata);
  * \retval I2CERROR : 失败
  *
  */
+I2CResult I2CBusReadReg(I2CBus * bus, uint8_t address, uint8_t reg, uint8_t * I2Cdata);
+
+
+/**
+ * 连续读取多个字节数据，除最后一个字节外每个字节后发送ACK，最后一个字节后发送NOACK
+ * 
+ * \param bus     : 总线对象指针
+ * \param address : 从设备地址
+ * \param count   : 数据长度，不能为0
+ * \param I2Cdata : 读取到的数据存放数组
+ *
+ * \return 执行结果
+ * \retval I2COK    : 成功
+ * \retval I2CERROR : 失败
+ *
+ */
+I2CResult I2CBusReadMultiBytes(I2CBus * bus, uint8_t address, uint8_t count, uint8_t I2Cdata[]);
+
+
+/**
+ * 从指定寄存器开始连续读取多个寄存器，寄存器地址由从设备自动递增。
+ * 只需发送一次设备地址和寄存器地址，读取6字节时SCL时钟数为6次I2CReadReg的约1/3
+ * 
+ * \param bus     : 总线对象指针
+ * \param address : 从设备地址
+ * \param reg     : 起始寄存器地址
+ * \param count   : 数据长度，不能为0
+ * \param I2Cdata : 读取到的数据存放数组
+ *
+ * \return 执行结果
+ * \retval I2COK    : 成功
+ * \retval I2CERROR : 失败
+ *
+ */
+I2CResult I2CBusReadRegs(I2CBus * bus, uint8_t address, uint8_t reg, uint8_t count, uint8_t I2Cdata[]);
+
+
+/**
+ * 连续执行多个读写操作，操作之间使用重复Start，不发送Stop信号和等待总线空闲时间。
+ * 带I2C_OP_AUTO_INC标志的写寄存器操作，如果与上一个操作是同一从设备的写寄存器操作，
+ * 且寄存器地址连续，则直接发送数据，不再发送设备地址和寄存器地址。
+ * 从设备无应答时发送Stop信号并停止执行
+ * 
+ * \param bus   : 总线对象指针
+ * \param ops   : 操作数组，执行后每个操作的result为执行结果，未执行的操作为I2CERROR
+ * \param count : 操作个数
+ *
+ * \return 成功执行的操作个数，等于count时全部成功
+ *
+ */
+uint8_t I2CBusBatch(I2CBus * bus, I2COp ops[], uint8_t count);
+
+
+/**
+ * 统计信息清零，并清除传输段记录
+ *
+ * \param bus : 总线对象指针
+ *
+ */
+void I2CBusResetStats(I2CBus * bus);
+
+#ifdef I2C_STATS
+/**
+ * 计算总线占用率
+ *
+ * \param bus : 总线对象指针
+ * \param ms  : I2CBusResetStats之后经过的时间(ms)，由调用者计时
+ *
+ * \return 占用率(%)，0~100
+ *
+ */
+uint8_t I2CBusBusyPercent(I2CBus * bus, uint32_t ms);
+
+#if I2C_TRACE_SIZE > 0
+/**
+ * 从最早到最近依次输出传输段记录，每个记录按I2CTraceEntry的成员顺序输出7个字节，可直接发送到串口
+ *
+ * \param bus : 总线对象指针
+ * \param put : 输出一个字节的函数，如串口发送函数
+ *
+ * \return 输出的记录个数
+ *
+ */
+uint8_t I2CBusTraceDump(I2CBus * bus, void (*put)(uint8_t c));
+#endif
+#endif
+
+
+#ifndef I2C_NO_DEFAULT_BUS
+/** 默认总线，使用HAL宏定义的引脚，以下原有函数均使用此总线 */
+extern I2CBus I2CDefaultBus;
+
+/** 同I2CBusSetSpeed，使用默认总线 */
+I2CResult I2CSetSpeed(I2CSpeed speed);
+
+/** 同I2CBusSCLTestOut，使用默认总线 */
+uint32_t SCLTestOut(void);
+
+/** 同I2CBusWriteByte，使用默认总线 */
+I2CResult I2CWriteByte(uint8_t address, uint8_t I2Cdata);
+
+/** 同I2CBusWriteMultiBytes，使用默认总线 */
+I2CResult I2CWriteMultiBytes(uint8_t address, uint8_t count, uint8_t I2Cdata[]);
+
+/** 同I2CBusWriteReg，使用默认总线 */
+I2CResult I2CWriteReg(uint8_t address, uint8_t reg, uint8_t I2Cdata);
+
+/** 同I2CBusWriteBlock，使用默认总线 */
+I2CResult I2CWriteBlock(uint8_t address, uint8_t hcount, const uint8_t head[], uint16_t count, const uint8_t I2Cdata[]);
+
+/** 同I2CBusReadByte，使用默认总线 */
+I2CResult I2CReadByte(uint8_t address, uint8_t * I2Cdata);
+
+/** 同I2CBusReadReg，使用默认总线 */
 I2CResult I2CReadReg(uint8_t address, uint8_t reg, uint8_t * I2Cdata);
+
+/** 同I2CBusReadMultiBytes，使用默认总线 */
+I2CResult I2CReadMultiBytes(uint8_t address, uint8_t count, uint8_t I2Cdata[]);
+
+/** 同I2CBusReadRegs，使用默认总线 */
+I2CResult I2CReadRegs(uint8_t address, uint8_t reg, uint8_t count, uint8_t I2Cdata[]);
+
+/** 同I2CBusBatch，使用默认总线 */
+uint8_t I2CBatch(I2COp ops[], uint8_t count);
+#endif
  
 #endif
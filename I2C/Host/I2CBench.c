@@ -0,0 +1,699 @@
+/**
+ * \file
+ *
+ * \brief GPIO_I2C在Linux主机仿真总线上的回归测试及总线时间测量
+ *
+ * \author 高明飞
+ *
+ * \date 2026-10-18
+ *
+ * \details
+ * 在默认总线上挂24C02、24C256、寄存器型设备和XFS5152CE替身（使用XFS5152CE程序），对每个总线速度执行一组操作，
+ * I2C_Async的传输按总线速度的2倍频率调用I2CAsyncISR模拟定时器中断，
+ * 最后在8路共用SCL的仿真总线上测试I2C_Parallel，
+ * 检查读写结果，并输出每个操作的SCL时钟个数、字节数、总线时间、其中的延时和时钟延展时间(us)，
+ * 以及包括EEPROM写周期等待在内的总时间(us)。
+ * 仿真时间与主机速度无关，输出可直接与修改前的结果比较；有错误时返回1。
+ *
+ * 编译：
+ *   gcc -O2 -DI2C_HOST -II2C -II2C/Host -ITypeDef \
+ *       -IXFS5152CE I2C/GPIO_I2C.c I2C/I2C_Eeprom.c I2C/I2C_RegCache.c I2C/I2C_Async.c \
+ *       I2C/I2C_Parallel.c XFS5152CE/XFS5152CE.c I2C/Host/I2C_Host.c I2C/Host/I2CBench.c -o I2CBench
+ * 加-DI2C_STATS时最后输出默认总线的统计信息和最近的传输段记录。
+ * 运行：
+ *   ./I2CBench
+ *
+ * 修改记录：\n
+ *
+ * 2026-10-18 :\n
+ *   -File Created.\n
+ *   -增加I2C_Eeprom的逐字节写入对比测试，输出总时间.\n
+ *   -增加I2C_RegCache的读-改-写对比测试.\n
+ *   -定义I2C_STATS时输出默认总线的统计信息和最近的传输段记录.\n
+ *   -XFS5152CE替身改为通过XFS5152CE程序初始化，增加长文本流式合成测试.\n
+ *   -增加I2C_Async的写入、写入+读取、无应答和时钟延展超时测试.\n
+ *   -增加I2C_Parallel的8路并行读写测试.\n
+ *
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "GPIO_I2C.h"
+#include "I2C_Eeprom.h"
+#include "I2C_RegCache.h"
+#include "I2C_Async.h"
+#include "I2C_Parallel.h"
+#include "XFS5152CE.h"
+
+/* 从设备地址 */
+#define ADDR_EEP    0x50
+#define ADDR_EEP16  0x54
+#define ADDR_REGS   0x68
+#define ADDR_XFS    0x40
+
+/* 时钟延展的从设备地址，每个字节的ACK位前拉低SCL 10us */
+#define ADDR_STRETCH 0x69
+
+/* 卡死的从设备地址，每个字节的ACK位前拉低SCL 10ms，超过I2C_ASYNC_STRETCH_TICKS次中断 */
+#define ADDR_STUCK 0x6A
+#define STUCK_TICKS (I2C_HOST_TICK_HZ / 100)
+
+/* I2C_Parallel的总线个数（最后一路没有从设备）及每路读写的字节数 */
+#define PAR_NUM   I2CP_BUS_NUM
+#define PAR_COUNT 6
+
+/* EEPROM块写入测试的长度 */
+#define EEP_BLOCK 2048
+
+/* 逐字节写入时每个字节后的固定等待时间(us)，为24C256的最长写周期 */
+#define EEP_TWR_US 5000
+
+/* 流式合成测试的字符数、每句的字符数，及调用XFS5152CE_Stream_Poll的间隔(us) */
+#define SPEAK_CHARS 260
+#define SPEAK_SENTENCE 38
+#define SPEAK_POLL_US 1000
+
+/* 每帧在XFS_STREAM_MIN_CHARS之后的第一个句号处拆分，包含一个句子 */
+#define SPEAK_FRAME (SPEAK_SENTENCE + 1)
+
+/* 文本缓存长文本测试的字符数，超过两段XFS_CACHE_CHARS，每段在最后一个句号处分段 */
+#define CACHE_LONG_CHARS (2 * XFS_CACHE_CHARS + 300)
+
+/* 计数值换算为us */
+#define TICKS_US(t) ((double)(t) * 1e6 / I2C_HOST_TICK_HZ)
+
+static uint8_t EepMem[256];
+static uint8_t Eep16Mem[32768];
+static I2CHostEeprom Eep;
+static I2CHostEeprom Eep16;
+static I2CHostRegs Regs;
+static I2CHostRegs Stretch;
+static I2CHostRegs Stuck;
+static I2CHostXfs Xfs;
+static I2CEeprom Eeprom16;
+static I2CHostBus ParBus[PAR_NUM];
+static I2CHostRegs ParRegs[PAR_NUM - 1];
+
+/* 寄存器0xC0~0xDF使用缓存，其中0xC0~0xC7为易失寄存器 */
+static const uint8_t CacheVolatile[I2C_REGCACHE_BITS(32)] = { 0xFF };
+static uint8_t CacheMem[I2C_REGCACHE_MEM(32)];
+static I2CRegCache Cache;
+
+static uint8_t Data[64];
+static uint8_t Buf[64];
+static uint8_t Block[EEP_BLOCK];
+static uint8_t BlockBuf[EEP_BLOCK];
+static uint8_t Speech[SPEAK_CHARS * 2];
+static uint8_t LongSpeech[CACHE_LONG_CHARS * 2];
+static unsigned Errors;
+
+/* 模拟的定时器中断间隔（计数值），为当前总线速度的半个周期 */
+static uint32_t AsyncHalf;
+
+/* 测试项的附加说明，输出在该项的结果之后 */
+static char Note[64];
+
+/* 检查结果，错误时输出并计数 */
+static void Check(int ok, const char * what)
+{
+	if(!ok)
+	{
+		printf("  FAIL: %s\n", what);
+		Errors++;
+	}
+}
+
+/* 等待EEPROM写周期结束 */
+static void EepWait(I2CHostEeprom * eep)
+{
+	if(I2CHostNow() < eep->busyUntil)
+		I2CHostAdvance((uint32_t)(eep->busyUntil - I2CHostNow()));
+}
+
+/* 测试项 */
+static void TestWriteReg(void)
+{
+	Check(I2CWriteReg(ADDR_REGS, 0x10, 0xA5) == I2COK && Regs.regs[0x10] == 0xA5, "WriteReg");
+}
+
+static void TestReadReg(void)
+{
+	Regs.regs[0x20] = 0x3C;
+	Check(I2CReadReg(ADDR_REGS, 0x20, Buf) == I2COK && Buf[0] == 0x3C, "ReadReg");
+}
+
+static void TestReadRegs16(void)
+{
+	memcpy(&Regs.regs[0x40], Data, 16);
+	Check(I2CReadRegs(ADDR_REGS, 0x40, 16, Buf) == I2COK && memcmp(Buf, Data, 16) == 0, "ReadRegs(16)");
+}
+
+static void TestBatch8(void)
+{
+	I2COp ops[8];
+	uint8_t i;
+
+	for(i = 0; i < 8; i++)
+	{
+		ops[i].type = I2C_OP_WRITE_REG;
+		ops[i].flags = I2C_OP_AUTO_INC;
+		ops[i].address = ADDR_REGS;
+		ops[i].reg = 0x80 + i;
+		ops[i].value = Data[i];
+	}
+	Check(I2CBatch(ops, 8) == 8 && memcmp(&Regs.regs[0x80], Data, 8) == 0, "Batch(8)");
+}
+
+static void TestNack(void)
+{
+	Check(I2CWriteByte(0x11, 0x00) == I2CERROR, "NACK");
+}
+
+static void TestStretch(void)
+{
+	Stretch.regs[0x05] = 0x77;
+	Check(I2CReadReg(ADDR_STRETCH, 0x05, Buf) == I2COK && Buf[0] == 0x77, "stretch ReadReg");
+}
+
+static void TestEepPage(void)
+{
+	uint8_t frame[9];
+
+	/* 24C02，页大小8字节 */
+	EepWait(&Eep);
+	frame[0] = 0x18;
+	memcpy(frame + 1, Data, 8);
+	Check(I2CWriteMultiBytes(ADDR_EEP, 9, frame) == I2COK, "EEPROM page write");
+	Check(I2CWriteByte(ADDR_EEP, 0x18) == I2CERROR, "EEPROM busy NACK");
+	EepWait(&Eep);
+	Check(memcmp(&EepMem[0x18], Data, 8) == 0, "EEPROM page content");
+}
+
+static void TestEepRead(void)
+{
+	EepWait(&Eep);
+	Check(I2CReadRegs(ADDR_EEP, 0x18, 8, Buf) == I2COK && memcmp(Buf, Data, 8) == 0, "EEPROM read");
+}
+
+static void TestEep16Page(void)
+{
+	uint8_t frame[66];
+
+	/* 24C256，页大小64字节，16位字地址 */
+	EepWait(&Eep16);
+	frame[0] = 0x12;
+	frame[1] = 0x40;
+	memcpy(frame + 2, Data, 64);
+	Check(I2CWriteMultiBytes(ADDR_EEP16, 66, frame) == I2COK, "24C256 page write");
+	EepWait(&Eep16);
+	Check(memcmp(&Eep16Mem[0x1240], Data, 64) == 0, "24C256 page content");
+}
+
+static void TestEepBytewise(void)
+{
+	uint8_t frame[3];
+	uint16_t i;
+	I2CResult res = I2COK;
+
+	/* 原有做法：每个字节一次传输，之后固定等待最长写周期 */
+	EepWait(&Eep16);
+	for(i = 0; i < EEP_BLOCK && res == I2COK; i++)
+	{
+		frame[0] = (uint8_t)((0x2000 + i) >> 8);
+		frame[1] = (uint8_t)(0x2000 + i);
+		frame[2] = Block[i];
+		res = I2CWriteMultiBytes(ADDR_EEP16, 3, frame);
+		I2CHostAdvance(I2C_HOST_TICK_HZ / 1000000UL * EEP_TWR_US);
+	}
+	Check(res == I2COK && memcmp(&Eep16Mem[0x2000], Block, EEP_BLOCK) == 0, "24C256 bytewise");
+}
+
+static void TestEepromWrite(void)
+{
+	/* 起始地址不在页边界上，首尾为不完整的页 */
+	EepWait(&Eep16);
+	memset(&Eep16Mem[0x4010], 0, EEP_BLOCK);
+	Check(I2CEepromWrite(&Eeprom16, 0x4010, Block, EEP_BLOCK) == I2COK, "I2CEepromWrite");
+	Check(I2CEepromWait(&Eeprom16) == I2COK, "I2CEepromWait");
+	Check(memcmp(&Eep16Mem[0x4010], Block, EEP_BLOCK) == 0, "I2CEepromWrite content");
+}
+
+static void TestEepromRead(void)
+{
+	Check(I2CEepromRead(&Eeprom16, 0x4010, BlockBuf, EEP_BLOCK) == I2COK &&
+	      memcmp(BlockBuf, Block, EEP_BLOCK) == 0, "I2CEepromRead");
+	Check(I2CEepromRead(&Eeprom16, 0x7FF0, BlockBuf, 32) == I2CERROR, "I2CEepromRead range");
+}
+
+static void TestRmwPlain(void)
+{
+	uint8_t i, value;
+	I2CResult res = I2COK;
+
+	/* 原有做法：每次读-改-写都读取并写入，即使值不变 */
+	for(i = 0; i < 16 && res == I2COK; i++)
+	{
+		res = I2CReadReg(ADDR_REGS, 0x30 + i, &value);
+		if(res == I2COK)
+			res = I2CWriteReg(ADDR_REGS, 0x30 + i, (value & ~0x0F) | i);
+	}
+	Check(res == I2COK && (Regs.regs[0x35] & 0x0F) == 5, "RMW plain");
+}
+
+static void TestRmwCache(void)
+{
+	uint8_t i;
+	I2CResult res = I2COK;
+
+	/* 同样的修改，值不变，已缓存时没有总线传输 */
+	for(i = 0; i < 16 && res == I2COK; i++)
+		res = I2CRegCacheUpdate(&Cache, 0xC8 + i, 0x0F, i);
+	Check(res == I2COK && (Regs.regs[0xCD] & 0x0F) == 5, "RMW cache");
+}
+
+static void TestCacheFlush(void)
+{
+	static uint8_t round;
+	uint8_t i;
+	uint8_t value;
+
+	/* 回写模式修改0xD8、0xDA、0xDC、0xDE，跨过中间不变的寄存器合并为一次写入 */
+	round++;
+	Cache.writeBack = 1;
+	for(i = 0; i < 8; i += 2)
+		I2CRegCacheWrite(&Cache, 0xD8 + i, Data[i] + round);
+	Check(Regs.regs[0xD8] != (uint8_t)(Data[0] + round), "cache write-back deferred");
+	Check(I2CRegCacheFlush(&Cache) == I2COK, "cache flush");
+	Cache.writeBack = 0;
+	Check(Regs.regs[0xDE] == (uint8_t)(Data[6] + round), "cache flush content");
+
+	/* 易失寄存器每次都读取设备 */
+	Regs.regs[0xC3] = round;
+	Check(I2CRegCacheRead(&Cache, 0xC3, &value) == I2COK && value == round, "cache volatile read");
+}
+
+static void TestXfsStart(void)
+{
+	/* 合成"你好"：FD 00 06 01 03 60 4F 7D 59 */
+	static uint8_t frame[] = { 0xFD, 0x00, 0x06, 0x01, 0x03, 0x60, 0x4F, 0x7D, 0x59 };
+
+	Check(I2CWriteMultiBytes(ADDR_XFS, sizeof(frame), frame) == I2COK, "XFS frame");
+	Check(I2CReadByte(ADDR_XFS, Buf) == I2COK && Buf[0] == 0x41, "XFS 0x41");
+	Check(I2CHostXfsBusy(&Xfs), "XFS busy");
+}
+
+/* 按AsyncHalf的间隔调用I2CAsyncISR，直到传输结束 */
+static void AsyncRun(I2CAsyncTrans * trans)
+{
+	unsigned n;
+
+	for(n = 0; n < 100000 && (trans->state == I2C_ASYNC_PENDING || trans->state == I2C_ASYNC_BUSY); n++)
+	{
+		I2CHostAdvance(AsyncHalf);
+		I2CAsyncISR();
+	}
+}
+
+static void TestAsyncWrite(void)
+{
+	static uint8_t wr[3];
+	I2CAsyncTrans trans;
+
+	wr[0] = 0x60;
+	wr[1] = Data[1];
+	wr[2] = Data[2];
+	I2CAsyncSetup(&trans, ADDR_REGS, wr, 3, 0, 0, 0);
+	Check(I2CAsyncSubmit(&trans) == I2COK, "async submit");
+	AsyncRun(&trans);
+	Check(trans.state == I2C_ASYNC_DONE && Regs.regs[0x60] == Data[1] && Regs.regs[0x61] == Data[2],
+	      "async write");
+	Check(!I2CAsyncBusy(), "async idle");
+}
+
+static void TestAsyncWriteRead(void)
+{
+	static uint8_t reg = 0x40;
+	I2CAsyncTrans trans;
+
+	memcpy(&Regs.regs[0x40], Data + 8, 6);
+	memset(Buf, 0, 6);
+	I2CAsyncSetup(&trans, ADDR_REGS, &reg, 1, Buf, 6, 0);
+	I2CAsyncSubmit(&trans);
+	AsyncRun(&trans);
+	Check(trans.state == I2C_ASYNC_DONE && memcmp(Buf, Data + 8, 6) == 0, "async write+read");
+}
+
+static void TestAsyncNack(void)
+{
+	static uint8_t wr = 0x00;
+	I2CAsyncTrans trans;
+
+	I2CAsyncSetup(&trans, 0x11, &wr, 1, 0, 0, 0);
+	I2CAsyncSubmit(&trans);
+	AsyncRun(&trans);
+	Check(trans.state == I2C_ASYNC_ERROR, "async NACK");
+}
+
+static void TestAsyncStuck(void)
+{
+	static uint8_t wr[2] = { 0x05, 0x00 };
+	I2CAsyncTrans trans;
+
+	I2CAsyncSetup(&trans, ADDR_STUCK, wr, 2, 0, 0, 0);
+	I2CAsyncSubmit(&trans);
+	AsyncRun(&trans);
+	Check(trans.state == I2C_ASYNC_ERROR && I2CHostNow() < I2CHostDefault.sclHold, "async stretch timeout");
+
+	/* 从设备释放SCL后发送Start、Stop信号，使总线恢复空闲 */
+	I2CHostAdvance((uint32_t)(I2CHostDefault.sclHold - I2CHostNow()));
+	HAL_SDA_W(0);
+	HAL_SDA_W(1);
+	Check(I2CWriteReg(ADDR_REGS, 0x10, 0x5A) == I2COK && Regs.regs[0x10] == 0x5A, "bus after timeout");
+}
+
+/* I2C_Parallel：各路总线上地址相同的寄存器型设备，同时写入不同的数据再读回 */
+static void BenchParallel(void)
+{
+	static uint8_t wr[PAR_NUM * PAR_COUNT];
+	static uint8_t rd[PAR_NUM * PAR_COUNT];
+	uint64_t t0, tw, tr;
+	I2CPMask ok;
+	uint8_t b;
+
+	for(b = 0; b < PAR_NUM; b++)
+	{
+		I2CHostInit(&ParBus[b]);
+		if(b < PAR_NUM - 1)
+		{
+			I2CHostRegsInit(&ParRegs[b], ADDR_REGS);
+			I2CHostAttach(&ParBus[b], &ParRegs[b].slave);
+		}
+	}
+	I2CHostParallelInit(ParBus, PAR_NUM);
+	for(b = 0; b < sizeof(wr); b++)
+		wr[b] = (uint8_t)(Data[b] + b);
+
+	t0 = I2CHostNow();
+	ok = I2CPWriteRegs(I2CP_SDA_MASK, ADDR_REGS, 0x20, PAR_COUNT, wr);
+	tw = I2CHostNow() - t0;
+	Check(ok == (I2CPMask)(I2CP_SDA_MASK >> 1), "I2CPWriteRegs mask");
+	for(b = 0; b < PAR_NUM - 1; b++)
+		Check(memcmp(&ParRegs[b].regs[0x20], wr + b * PAR_COUNT, PAR_COUNT) == 0, "I2CPWriteRegs content");
+
+	t0 = I2CHostNow();
+	ok = I2CPReadRegs(I2CP_SDA_MASK, ADDR_REGS, 0x20, PAR_COUNT, rd);
+	tr = I2CHostNow() - t0;
+	Check(ok == (I2CPMask)(I2CP_SDA_MASK >> 1) && memcmp(rd, wr, (PAR_NUM - 1) * PAR_COUNT) == 0,
+	      "I2CPReadRegs");
+
+	printf("I2CParallel %u buses @%lukHz: I2CPWriteRegs(%u) %.1fus, I2CPReadRegs(%u) %.1fus, %lu cycles per bus\n",
+	       PAR_NUM, (unsigned long)(I2CP_SPEED_HZ / 1000), PAR_COUNT, TICKS_US(tw), PAR_COUNT, TICKS_US(tr),
+	       (unsigned long)ParBus[0].total.cycles);
+}
+
+#if defined(I2C_STATS) && I2C_TRACE_SIZE > 0
+/* I2CBusTraceDump输出的字节 */
+static uint8_t Dump[I2C_TRACE_SIZE * 7];
+static unsigned DumpLen;
+
+static void DumpPut(uint8_t c)
+{
+	Dump[DumpLen++] = c;
+}
+
+/* 输出传输段记录，并检查时间戳不减（间隔超过计数器回绕周期），及最近的两个记录：
+   XFS读取状态字节前的帧写入，及一次地址无应答 */
+static void PrintTrace(void)
+{
+	static const char * const ResultName[] = { "OK", "NACK addr", "NACK data", "timeout" };
+	uint8_t n, i;
+	uint8_t * e;
+	unsigned long t, last = 0;
+	int ordered = 1;
+
+	DumpLen = 0;
+	n = I2CBusTraceDump(&I2CDefaultBus, DumpPut);
+	printf("trace (%u):\n", n);
+	for(i = 0; i < n; i++)
+	{
+		e = &Dump[i * 7];
+		t = ((unsigned long)e[3] << 24) | ((unsigned long)e[4] << 16) | ((unsigned long)e[5] << 8) | e[6];
+		printf("  0x%02X %c %3u %-9s t=%luus\n", e[0] >> 1, (e[0] & 1) ? 'R' : 'W', e[1], ResultName[e[2] & 3], t);
+		if(t < last)
+			ordered = 0;
+		last = t;
+	}
+	Check(ordered, "trace time");
+	e = &Dump[(n - 2) * 7];
+	Check(n >= 2 && e[0] == (ADDR_XFS << 1) && e[1] == 3 && e[2] == I2C_TRACE_OK, "trace write");
+	e += 7;
+	Check(e[0] == (0x11 << 1) && e[1] == 0 && e[2] == I2C_TRACE_NACK_ADDR, "trace NACK");
+}
+#endif
+
+/* 流式合成SPEAK_CHARS个字符，检查帧数及没有打断正在合成的帧，停顿记入Note，返回发送的合成帧数 */
+static uint32_t XfsSpeakRun(void)
+{
+	uint32_t t0 = Xfs.text;
+	uint32_t frames = 1;
+	uint16_t left;
+	uint64_t start;
+	double gap;
+
+	/* 等待上一项的合成结束，之后按固定间隔调用XFS5152CE_Stream_Poll，模拟主循环 */
+	while(I2CHostXfsBusy(&Xfs))
+		I2CHostAdvance(I2C_HOST_TICK_HZ / 1000000UL * SPEAK_POLL_US);
+	start = I2CHostNow();
+	Check(XFS5152CE_Stream_Start(Speech, SPEAK_CHARS) == XFSOK, "XFS stream start");
+	while((left = XFS5152CE_Stream_Left()) != 0)
+	{
+		I2CHostAdvance(I2C_HOST_TICK_HZ / 1000000UL * SPEAK_POLL_US);
+		if(XFS5152CE_Stream_Poll() != XFSOK)
+		{
+			Check(0, "XFS stream poll");
+			break;
+		}
+		if(XFS5152CE_Stream_Left() != left)
+			frames++;
+	}
+
+	/* 帧之间的停顿：合成结束时刻减去开始时刻和合成时间，打断正在合成的帧时为负 */
+	gap = (double)Xfs.busyUntil - (double)start - (double)Xfs.charTicks * SPEAK_CHARS;
+	Check(Xfs.text - t0 == SPEAK_CHARS * 2 && frames == (SPEAK_CHARS + SPEAK_FRAME - 1) / SPEAK_FRAME,
+	      "XFS stream frames");
+	Check(gap >= 0, "XFS stream not interrupted");
+	snprintf(Note, sizeof(Note), "%u frames, gap %.1fus per frame", (unsigned)frames,
+	         frames > 1 ? TICKS_US(gap) / (frames - 1) : 0.0);
+	return frames;
+}
+
+static void TestXfsSpeak(void)
+{
+	XfsSpeakRun();
+}
+
+/* BUSY引脚未连接（始终为低电平），等待超时后改用状态查询 */
+static void TestXfsSpeakNoBusy(void)
+{
+	uint32_t f0 = Xfs.frames;
+	uint32_t frames;
+
+	I2CHostXfsPin = 0;
+	frames = XfsSpeakRun();
+	I2CHostXfsPin = &Xfs;
+	/* 合成帧之外为状态查询帧 */
+	Check(Xfs.frames - f0 > frames, "XFS stream status query");
+}
+
+/* 通过文本缓存合成text的chars个字符，检查分段数、缓存中最后一段的文本及没有打断正在播放的段，
+   开始播放前写入第一段的时间及每个分段处的停顿（写入下一段的时间）记入Note，段内没有停顿 */
+static void XfsCacheRun(const uint8_t * text, uint16_t chars, uint32_t segments)
+{
+	uint32_t t0 = Xfs.text;
+	uint32_t p0 = Xfs.cachePlays;
+	uint64_t start;
+	double first, gap;
+
+	while(I2CHostXfsBusy(&Xfs))
+		I2CHostAdvance(I2C_HOST_TICK_HZ / 1000000UL * SPEAK_POLL_US);
+	start = I2CHostNow();
+	Check(XFS5152CE_Cache_Start(text, chars) == XFSOK, "XFS cache start");
+	first = (double)(I2CHostNow() - start);
+	while(XFS5152CE_Stream_Left() != 0)
+	{
+		I2CHostAdvance(I2C_HOST_TICK_HZ / 1000000UL * SPEAK_POLL_US);
+		if(XFS5152CE_Stream_Poll() != XFSOK)
+		{
+			Check(0, "XFS cache poll");
+			break;
+		}
+	}
+
+	gap = (double)Xfs.busyUntil - (double)start - (double)Xfs.charTicks * chars;
+	Check(Xfs.text - t0 == (uint32_t)chars * 2 && Xfs.cachePlays - p0 == segments, "XFS cache segments");
+	Check(memcmp(Xfs.cache, text + chars * 2 - Xfs.cacheLen, Xfs.cacheLen) == 0, "XFS cache text");
+	Check(gap >= 0, "XFS cache not interrupted");
+	snprintf(Note, sizeof(Note), "%u segment(s), start %.1fus, gap %.1fus per segment", (unsigned)segments,
+	         TICKS_US(first), segments > 1 ? TICKS_US(gap - first) / (segments - 1) : 0.0);
+}
+
+static void TestXfsCache(void)
+{
+	XfsCacheRun(Speech, SPEAK_CHARS, 1);
+}
+
+static void TestXfsCacheLong(void)
+{
+	XfsCacheRun(LongSpeech, CACHE_LONG_CHARS, 3);
+}
+
+typedef struct
+{
+	const char * name;
+	void (*func)(void);
+} BenchItem;
+
+static const BenchItem Items[] =
+{
+	{ "I2CWriteReg",               TestWriteReg },
+	{ "I2CReadReg",                TestReadReg },
+	{ "I2CReadRegs(16)",           TestReadRegs16 },
+	{ "I2CBatch(8 merged)",        TestBatch8 },
+	{ "I2CWriteByte(NACK)",        TestNack },
+	{ "I2CReadReg(stretch 10us)",  TestStretch },
+	{ "24C02 page write(8)",       TestEepPage },
+	{ "24C02 read(8)",             TestEepRead },
+	{ "24C256 page write(64)",     TestEep16Page },
+	{ "24C256 2KiB bytewise+5ms",  TestEepBytewise },
+	{ "I2CEepromWrite(2KiB)",      TestEepromWrite },
+	{ "I2CEepromRead(2KiB)",       TestEepromRead },
+	{ "RMW(16) ReadReg+WriteReg",  TestRmwPlain },
+	{ "RMW(16) I2CRegCacheUpdate", TestRmwCache },
+	{ "I2CRegCacheFlush(4 dirty)", TestCacheFlush },
+	{ "XFS5152CE start",           TestXfsStart },
+	{ "XFS stream(260 chars)",     TestXfsSpeak },
+	{ "XFS stream(no BUSY pin)",   TestXfsSpeakNoBusy },
+	{ "XFS cache(260 chars)",      TestXfsCache },
+	{ "XFS cache(4396 chars)",     TestXfsCacheLong },
+	{ "I2CAsync write(3)",         TestAsyncWrite },
+	{ "I2CAsync write+read(1+6)",  TestAsyncWriteRead },
+	{ "I2CAsync NACK",             TestAsyncNack },
+	{ "I2CAsync stuck SCL",        TestAsyncStuck },
+};
+
+static const char * const SpeedName[] = { "100kHz", "400kHz", "1MHz" };
+static const uint32_t SpeedHz[] = { 100000, 400000, 1000000 };
+
+int main(void)
+{
+	unsigned i, k, s;
+	uint32_t n0;
+	uint64_t t0;
+	I2CHostTrans sum;
+	I2CResult res;
+
+	for(i = 0; i < sizeof(Data); i++)
+		Data[i] = (uint8_t)(i * 37 + 11);
+	for(i = 0; i < sizeof(Block); i++)
+		Block[i] = (uint8_t)(i * 13 + 5);
+
+	I2CHostEepromInit(&Eep, ADDR_EEP, EepMem, sizeof(EepMem), 8, 1, I2C_HOST_TICK_HZ / 200);
+	I2CHostEepromInit(&Eep16, ADDR_EEP16, Eep16Mem, sizeof(Eep16Mem), 64, 2, I2C_HOST_TICK_HZ / 200);
+	I2CEepromInit(&Eeprom16, &I2CDefaultBus, ADDR_EEP16, sizeof(Eep16Mem), 64, 2);
+	I2CHostRegsInit(&Regs, ADDR_REGS);
+	I2CRegCacheInit(&Cache, &I2CDefaultBus, ADDR_REGS, 0xC0, 32, CacheVolatile, CacheMem);
+	I2CHostRegsInit(&Stretch, ADDR_STRETCH);
+	Stretch.slave.stretch = I2C_HOST_TICK_HZ / 100000;
+	I2CHostRegsInit(&Stuck, ADDR_STUCK);
+	Stuck.slave.stretch = STUCK_TICKS;
+	I2CHostXfsInit(&Xfs, ADDR_XFS, I2C_HOST_TICK_HZ / 5);
+	I2CHostAttach(&I2CHostDefault, &Eep.slave);
+	I2CHostAttach(&I2CHostDefault, &Eep16.slave);
+	I2CHostAttach(&I2CHostDefault, &Regs.slave);
+	I2CHostAttach(&I2CHostDefault, &Stretch.slave);
+	I2CHostAttach(&I2CHostDefault, &Stuck.slave);
+	I2CHostAttach(&I2CHostDefault, &Xfs.slave);
+
+	/* 上电后状态查询返回0x4A、0x4F，之后恢复默认合成参数 */
+	I2CHostXfsPin = &Xfs;
+	Check(XFS5152CE_Init() == XFSOK && Xfs.frames == 2, "XFS5152CE_Init");
+
+	/* 每SPEAK_SENTENCE个汉字后一个句号 */
+	for(i = 0; i < SPEAK_CHARS; i++)
+	{
+		k = (i % (SPEAK_SENTENCE + 1) == SPEAK_SENTENCE) ? 0x3002 : 0x4E00 + i;
+		Speech[2 * i] = (uint8_t)k;
+		Speech[2 * i + 1] = (uint8_t)(k >> 8);
+	}
+	for(i = 0; i < CACHE_LONG_CHARS; i++)
+	{
+		k = (i % (SPEAK_SENTENCE + 1) == SPEAK_SENTENCE) ? 0x3002 : 0x4E00 + i;
+		LongSpeech[2 * i] = (uint8_t)k;
+		LongSpeech[2 * i + 1] = (uint8_t)(k >> 8);
+	}
+
+	/* 读-改-写测试的寄存器初值，读取到缓存 */
+	for(i = 0; i < 16; i++)
+	{
+		Regs.regs[0x30 + i] = (uint8_t)(i | 0xA0);
+		Regs.regs[0xC8 + i] = (uint8_t)(i | 0xA0);
+	}
+	n0 = Regs.reads;
+	Check(I2CRegCacheLoad(&Cache) == I2COK && Regs.reads - n0 == 24, "cache load skips volatile");
+
+	for(s = 0; s < sizeof(SpeedName) / sizeof(SpeedName[0]); s++)
+	{
+		/* 按I2C_HOST_PIN_TICKS的端口操作时间，可能达不到较高的速度 */
+		res = I2CSetSpeed((I2CSpeed)s);
+		AsyncHalf = I2C_HOST_TICK_HZ / 2 / SpeedHz[s];
+		printf("%s: SCL %lu Hz%s\n", SpeedName[s], (unsigned long)SCLTestOut(),
+		       res == I2COK ? "" : " (I2CSetSpeed: too slow)");
+		printf("  %-26s %6s %6s %6s %10s %10s %10s %11s\n", "operation", "trans", "cycles", "bytes", "bus(us)", "delay(us)", "stretch(us)", "total(us)");
+
+		for(k = 0; k < sizeof(Items) / sizeof(Items[0]); k++)
+		{
+			/* 一个测试项可能包含多次传输，取所有传输之和 */
+			I2CHostResetStats(&I2CHostDefault);
+			n0 = I2CHostDefault.count;
+			t0 = I2CHostNow();
+			Items[k].func();
+			sum = I2CHostDefault.total;
+			printf("  %-26s %6lu %6lu %6lu %10.1f %10.1f %10.1f %11.1f\n", Items[k].name,
+			       (unsigned long)(I2CHostDefault.count - n0), (unsigned long)sum.cycles,
+			       (unsigned long)sum.bytes, TICKS_US(sum.ticks), TICKS_US(sum.delay),
+			       TICKS_US(sum.stretch), TICKS_US(I2CHostNow() - t0));
+			if(Note[0] != 0)
+			{
+				printf("  %-26s %s\n", "", Note);
+				Note[0] = 0;
+			}
+		}
+	}
+
+	BenchParallel();
+
+#ifdef I2C_STATS
+	/* 最后两个传输段：3个字节的写入，地址无应答 */
+	{
+		static uint8_t frame[] = { 0xFD, 0x00, 0x00 };
+
+		I2CWriteMultiBytes(ADDR_XFS, sizeof(frame), frame);
+		I2CWriteByte(0x11, 0x00);
+	}
+	/* stretch、busy的单位为HAL_I2C_STATS_TIME()的计数，仿真时为us */
+	printf("stats: trans %lu, bytes %lu, nacks %lu (address %lu), polls %lu, timeouts %lu, stretch %luus, busy %.1fms (%u%%)\n",
+	       (unsigned long)I2CDefaultBus.stats.trans, (unsigned long)I2CDefaultBus.stats.bytes,
+	       (unsigned long)I2CDefaultBus.stats.nacks, (unsigned long)I2CDefaultBus.stats.nackAddr,
+	       (unsigned long)I2CDefaultBus.stats.polls,
+	       (unsigned long)I2CDefaultBus.stats.timeouts, (unsigned long)I2CDefaultBus.stats.stretch,
+	       I2CDefaultBus.stats.busy / 1000.0,
+	       I2CBusBusyPercent(&I2CDefaultBus, (uint32_t)(I2CHostNow() / (I2C_HOST_TICK_HZ / 1000))));
+#if I2C_TRACE_SIZE > 0
+	PrintTrace();
+#endif
+#endif
+
+	printf("%u error(s)\n", Errors);
+	return Errors != 0;
+}
@@ -0,0 +1,911 @@
+/**
+ * \file
+ *
+ * \brief GPIO_I2C的Linux主机仿真底层实现
+ *
+ * \author 高明飞
+ *
+ * \date 2026-10-18
+ *
+ * \details
+ * 协议在主机的SCL、SDA边沿上处理：
+ *   - SCL为高电平时SDA下降为Start信号，上升为Stop信号
+ *   - SCL上升沿：从设备采样数据位或主机的ACK位
+ *   - SCL下降沿：第8个时钟后从设备给出ACK（并按slave->stretch拉低SCL），
+ *     第9个时钟后释放SDA；读取时从设备在下降沿后输出下一位
+ * 主机释放SCL时如从设备仍在拉低SCL，实际的上升沿推迟到sclHold时刻，SDA在此期间不变，
+ * 因此采样仍在主机释放SCL时进行。
+ *
+ * 修改记录：\n
+ *
+ * 2026-10-18 :\n
+ *   -File Created.\n
+ *
+ */
+
+#include <string.h>
+
+#include "GPIO_I2C.h"
+
+#ifndef I2C_DELAY_TIMER
+#error "I2C_HOST需要定义I2C_DELAY_TIMER，循环延时不消耗仿真时间"
+#endif
+
+/* 协议状态 */
+#define HOST_IDLE   0  /* Stop之后 */
+#define HOST_ADDR   1  /* 接收地址字节 */
+#define HOST_WRITE  2  /* 从设备接收数据 */
+#define HOST_READ   3  /* 从设备发送数据 */
+#define HOST_IGNORE 4  /* 未寻址到从设备或传输已结束，等待Start或Stop */
+
+/* 仿真时间 */
+static uint64_t _I2CHostTime;
+/* 读取计数器消耗的总时间 */
+static uint64_t _I2CHostWait;
+
+/** 默认总线使用的仿真总线 */
+I2CHostBus I2CHostDefault = { 1, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, {0}, {0}, {0}, 0, 0 };
+
+/* BUSY引脚连接的XFS5152CE替身 */
+I2CHostXfs * I2CHostXfsPin;
+
+/* I2C_Parallel使用的仿真总线组 */
+static I2CHostBus * _I2CHostParallel;
+static uint8_t _I2CHostParallelNum;
+
+/* 内部使用的函数声明 */
+static void _I2CHostStart(I2CHostBus * bus);
+static void _I2CHostStop(I2CHostBus * bus);
+static void _I2CHostRise(I2CHostBus * bus);
+static void _I2CHostFall(I2CHostBus * bus);
+static I2CHostSlave * _I2CHostFind(I2CHostBus * bus, uint8_t address);
+static void _I2CHostScl(I2CHostBus * bus, uint8_t state);
+static void _I2CHostSda(I2CHostBus * bus, uint8_t state);
+static void _I2CHostSclW(void * hw, uint8_t state);
+static void _I2CHostSdaW(void * hw, uint8_t state);
+static uint8_t _I2CHostSclR(void * hw);
+static uint8_t _I2CHostSdaR(void * hw);
+static uint8_t _I2CHostEepromStart(I2CHostSlave * slave, uint8_t address, uint8_t read);
+static uint8_t _I2CHostEepromWrite(I2CHostSlave * slave, uint8_t data);
+static uint8_t _I2CHostEepromRead(I2CHostSlave * slave);
+static void _I2CHostEepromStop(I2CHostSlave * slave);
+static uint8_t _I2CHostRegsStart(I2CHostSlave * slave, uint8_t address, uint8_t read);
+static uint8_t _I2CHostRegsWrite(I2CHostSlave * slave, uint8_t data);
+static uint8_t _I2CHostRegsRead(I2CHostSlave * slave);
+static uint8_t _I2CHostXfsStart(I2CHostSlave * slave, uint8_t address, uint8_t read);
+static uint8_t _I2CHostXfsWrite(I2CHostSlave * slave, uint8_t data);
+static uint8_t _I2CHostXfsRead(I2CHostSlave * slave);
+static void _I2CHostXfsStop(I2CHostSlave * slave);
+static void _I2CHostXfsReply(I2CHostXfs * xfs, uint8_t reply);
+
+/* I2CBus引脚操作，hw为I2CHostBus指针 */
+static const I2CBusOps _I2CHostOps = { _I2CHostSclW, _I2CHostSdaW, _I2CHostSclR, _I2CHostSdaR };
+
+/* 从设备模型的操作 */
+static const I2CHostSlaveOps _I2CHostEepromOps =
+{
+	_I2CHostEepromStart, _I2CHostEepromWrite, _I2CHostEepromRead, _I2CHostEepromStop
+};
+static const I2CHostSlaveOps _I2CHostRegsOps =
+{
+	_I2CHostRegsStart, _I2CHostRegsWrite, _I2CHostRegsRead, 0
+};
+static const I2CHostSlaveOps _I2CHostXfsOps =
+{
+	_I2CHostXfsStart, _I2CHostXfsWrite, _I2CHostXfsRead, _I2CHostXfsStop
+};
+
+/**
+ * 初始化仿真总线，释放SCL、SDA，清除从设备和统计信息
+ *
+ * \param bus : 仿真总线指针
+ *
+ */
+void I2CHostInit(I2CHostBus * bus)
+{
+	memset(bus, 0, sizeof(*bus));
+	bus->scl = 1;
+	bus->sda = 1;
+}
+
+
+/**
+ * 初始化连接到仿真总线的I2CBus总线对象
+ *
+ * \param i2c : I2CBus总线对象指针
+ * \param bus : 已初始化的仿真总线
+ *
+ */
+void I2CHostBusInit(I2CBus * i2c, I2CHostBus * bus)
+{
+	I2CBusInit(i2c, &_I2CHostOps, bus);
+}
+
+
+/**
+ * 将从设备挂到仿真总线上
+ *
+ * \param bus   : 仿真总线指针
+ * \param slave : 已初始化的从设备模型的slave成员
+ *
+ */
+void I2CHostAttach(I2CHostBus * bus, I2CHostSlave * slave)
+{
+	slave->next = bus->slaves;
+	bus->slaves = slave;
+}
+
+
+/**
+ * 清除仿真总线的统计信息
+ *
+ * \param bus : 仿真总线指针
+ *
+ */
+void I2CHostResetStats(I2CHostBus * bus)
+{
+	memset(&bus->last, 0, sizeof(bus->last));
+	memset(&bus->total, 0, sizeof(bus->total));
+	bus->count = 0;
+}
+
+
+/**
+ * 返回当前仿真时间（计数值）
+ *
+ */
+uint64_t I2CHostNow(void)
+{
+	return _I2CHostTime;
+}
+
+
+/**
+ * 仿真时间前进，用于模拟主程序中的其他操作
+ *
+ * \param ticks : 前进的时间（计数值）
+ *
+ */
+void I2CHostAdvance(uint32_t ticks)
+{
+	_I2CHostTime += ticks;
+}
+
+
+/**
+ * 读取计数器，消耗I2C_HOST_COUNTER_TICKS，计入传输中的延时时间
+ *
+ * \return 仿真时间的低32位
+ *
+ */
+uint32_t I2CHostTicks(void)
+{
+	_I2CHostTime += I2C_HOST_COUNTER_TICKS;
+	_I2CHostWait += I2C_HOST_COUNTER_TICKS;
+	return (uint32_t)_I2CHostTime;
+}
+
+
+/**
+ * 主机SCL输出，1为释放，0为拉低
+ *
+ * \param bus   : 仿真总线指针
+ * \param state : 输出电平
+ *
+ */
+void I2CHostSclWrite(I2CHostBus * bus, uint8_t state)
+{
+	_I2CHostTime += I2C_HOST_PIN_TICKS;
+	_I2CHostScl(bus, state);
+}
+
+
+/**
+ * 主机SDA输出，1为释放，0为拉低
+ *
+ * \param bus   : 仿真总线指针
+ * \param state : 输出电平
+ *
+ */
+void I2CHostSdaWrite(I2CHostBus * bus, uint8_t state)
+{
+	_I2CHostTime += I2C_HOST_PIN_TICKS;
+	_I2CHostSda(bus, state);
+}
+
+
+/**
+ * 读取SCL的实际电平（主机与从设备输出的线与）
+ *
+ * \param bus : 仿真总线指针
+ *
+ * \return 电平，0或1
+ *
+ */
+uint8_t I2CHostSclRead(I2CHostBus * bus)
+{
+	_I2CHostTime += I2C_HOST_PIN_TICKS;
+	return bus->scl && _I2CHostTime >= bus->sclHold;
+}
+
+
+/**
+ * 读取SDA的实际电平（主机与从设备输出的线与）
+ *
+ * \param bus : 仿真总线指针
+ *
+ * \return 电平，0或1
+ *
+ */
+uint8_t I2CHostSdaRead(I2CHostBus * bus)
+{
+	_I2CHostTime += I2C_HOST_PIN_TICKS;
+	return bus->sda && !bus->slaveSda;
+}
+
+
+/**
+ * 设置I2C_Parallel使用的仿真总线组，第b路总线的SDA为端口的第b位，各路共用SCL
+ *
+ * \param buses : 已初始化的仿真总线数组
+ * \param num   : 总线个数，1~8
+ *
+ */
+void I2CHostParallelInit(I2CHostBus * buses, uint8_t num)
+{
+	_I2CHostParallel = buses;
+	_I2CHostParallelNum = num;
+}
+
+
+/**
+ * 同时写各路总线的SCL，消耗一次引脚操作的仿真时间
+ *
+ * \param state : 输出电平，1为释放，0为拉低
+ *
+ */
+void I2CHostParallelSclWrite(uint8_t state)
+{
+	uint8_t b;
+
+	_I2CHostTime += I2C_HOST_PIN_TICKS;
+	for(b = 0; b < _I2CHostParallelNum; b++)
+		_I2CHostScl(&_I2CHostParallel[b], state);
+}
+
+
+/**
+ * 同时写各路总线的SDA，消耗一次引脚操作的仿真时间
+ *
+ * \param bits : 第b位为第b路总线的SDA电平
+ *
+ */
+void I2CHostParallelSdaWrite(uint8_t bits)
+{
+	uint8_t b;
+
+	_I2CHostTime += I2C_HOST_PIN_TICKS;
+	for(b = 0; b < _I2CHostParallelNum; b++)
+		_I2CHostSda(&_I2CHostParallel[b], (bits >> b) & 0x01);
+}
+
+
+/**
+ * 读取共用的SCL，任何一路的从设备拉低SCL时为0，消耗一次引脚操作的仿真时间
+ *
+ * \return 电平，0或1
+ *
+ */
+uint8_t I2CHostParallelSclRead(void)
+{
+	uint8_t b;
+
+	_I2CHostTime += I2C_HOST_PIN_TICKS;
+	for(b = 0; b < _I2CHostParallelNum; b++)
+	{
+		if(!_I2CHostParallel[b].scl || _I2CHostTime < _I2CHostParallel[b].sclHold)
+			return 0;
+	}
+	return 1;
+}
+
+
+/**
+ * 同时读取各路总线的SDA，消耗一次引脚操作的仿真时间
+ *
+ * \return 第b位为第b路总线的SDA电平，没有总线的位为1
+ *
+ */
+uint8_t I2CHostParallelSdaRead(void)
+{
+	uint8_t b;
+	uint8_t bits = 0xFF;
+
+	_I2CHostTime += I2C_HOST_PIN_TICKS;
+	for(b = 0; b < _I2CHostParallelNum; b++)
+	{
+		if(!_I2CHostParallel[b].sda || _I2CHostParallel[b].slaveSda)
+			bits &= (uint8_t)~(1 << b);
+	}
+	return bits;
+}
+
+
+/**
+ * 初始化24Cxx EEPROM模型
+ *
+ * \param eep        : 模型指针
+ * \param address    : 7位地址，如0x50，addrBytes为1且容量大于256字节时低位为块地址
+ * \param mem        : 存储内容，size字节
+ * \param size       : 容量（字节），如24C02为256，24C256为32768
+ * \param page       : 页大小（字节），不大于I2C_HOST_EEPROM_PAGE_MAX
+ * \param addrBytes  : 字地址字节数，24C01~24C16为1，24C32及以上为2
+ * \param writeTicks : 写周期时间tWR（计数值），如5ms
+ *
+ */
+void I2CHostEepromInit(I2CHostEeprom * eep, uint8_t address, uint8_t * mem, uint32_t size,
+                       uint16_t page, uint8_t addrBytes, uint32_t writeTicks)
+{
+	memset(eep, 0, sizeof(*eep));
+	eep->slave.address = address;
+	/* 24C04~24C16：字地址的高位在设备地址的低3位中 */
+	eep->slave.mask = addrBytes == 1 ? (uint8_t)(((size - 1) >> 8) & 0x07) : 0;
+	eep->slave.ops = &_I2CHostEepromOps;
+	eep->mem = mem;
+	eep->size = size;
+	eep->page = page;
+	eep->addrBytes = addrBytes;
+	eep->writeTicks = writeTicks;
+}
+
+
+/**
+ * 初始化通用寄存器型设备模型，寄存器清零
+ *
+ * \param regs    : 模型指针
+ * \param address : 7位地址
+ *
+ */
+void I2CHostRegsInit(I2CHostRegs * regs, uint8_t address)
+{
+	memset(regs, 0, sizeof(*regs));
+	regs->slave.address = address;
+	regs->slave.ops = &_I2CHostRegsOps;
+}
+
+
+/**
+ * 初始化XFS5152CE替身模型，上电后第一次读取返回0x4A
+ *
+ * \param xfs       : 模型指针
+ * \param address   : 7位地址，一般为0x40
+ * \param charTicks : 合成每个字符的时间（计数值）
+ *
+ */
+void I2CHostXfsInit(I2CHostXfs * xfs, uint8_t address, uint32_t charTicks)
+{
+	memset(xfs, 0, sizeof(*xfs));
+	xfs->slave.address = address;
+	xfs->slave.ops = &_I2CHostXfsOps;
+	xfs->charTicks = charTicks;
+	_I2CHostXfsReply(xfs, 0x4A);
+}
+
+
+/**
+ * 查询XFS5152CE替身是否正在合成，相当于读取BUSY引脚
+ *
+ * \param xfs : 模型指针
+ *
+ * \return 正在合成时返回1，否则返回0
+ *
+ */
+uint8_t I2CHostXfsBusy(I2CHostXfs * xfs)
+{
+	return _I2CHostTime < xfs->busyUntil;
+}
+
+
+/**
+ * 读取I2CHostXfsPin的BUSY引脚，消耗一次引脚操作的仿真时间
+ *
+ * \return 正在合成时返回1，否则返回0
+ *
+ */
+uint8_t I2CHostXfsBusyRead(void)
+{
+	_I2CHostTime += I2C_HOST_PIN_TICKS;
+	return I2CHostXfsPin != 0 && I2CHostXfsBusy(I2CHostXfsPin);
+}
+
+
+/**
+ * 主机SCL输出，不消耗仿真时间
+ */
+static void _I2CHostScl(I2CHostBus * bus, uint8_t state)
+{
+	state = state ? 1 : 0;
+	if(state == bus->scl)
+		return;
+
+	bus->scl = state;
+	if(state)
+	{
+		if(bus->busy)
+		{
+			bus->trans.cycles++;
+			if(bus->sclHold > _I2CHostTime)
+			{
+				bus->trans.stretch += (uint32_t)(bus->sclHold -
+					(bus->stretchEnd > _I2CHostTime ? bus->stretchEnd : _I2CHostTime));
+				bus->stretchEnd = bus->sclHold;
+			}
+		}
+		_I2CHostRise(bus);
+	}
+	else
+	{
+		_I2CHostFall(bus);
+	}
+}
+
+/**
+ * 主机SDA输出，不消耗仿真时间
+ */
+static void _I2CHostSda(I2CHostBus * bus, uint8_t state)
+{
+	state = state ? 1 : 0;
+	if(state == bus->sda)
+		return;
+
+	bus->sda = state;
+	/* 从设备拉低SDA时总线电平不变；SCL为高电平时SDA的变化为Start或Stop信号 */
+	if(bus->slaveSda || !bus->scl || _I2CHostTime < bus->sclHold)
+		return;
+	if(state)
+		_I2CHostStop(bus);
+	else
+		_I2CHostStart(bus);
+}
+
+/**
+ * Start信号（含重复Start），开始新的一次传输或继续当前传输
+ */
+static void _I2CHostStart(I2CHostBus * bus)
+{
+	if(!bus->busy)
+	{
+		bus->busy = 1;
+		bus->start = _I2CHostTime;
+		bus->delayStart = _I2CHostWait;
+		memset(&bus->trans, 0, sizeof(bus->trans));
+	}
+	bus->cur = 0;
+	bus->state = HOST_ADDR;
+	bus->bit = 0;
+	bus->rose = 0;
+	bus->shift = 0;
+	bus->slaveSda = 0;
+}
+
+/**
+ * Stop信号，结束本次传输并更新统计信息
+ */
+static void _I2CHostStop(I2CHostBus * bus)
+{
+	if(bus->cur != 0 && bus->cur->ops->Stop != 0)
+		bus->cur->ops->Stop(bus->cur);
+	bus->cur = 0;
+	bus->state = HOST_IDLE;
+	bus->slaveSda = 0;
+
+	if(!bus->busy)
+		return;
+	bus->busy = 0;
+	bus->trans.ticks = (uint32_t)(_I2CHostTime - bus->start);
+	bus->trans.delay = (uint32_t)(_I2CHostWait - bus->delayStart);
+	bus->last = bus->trans;
+	bus->total.cycles += bus->trans.cycles;
+	bus->total.bytes += bus->trans.bytes;
+	bus->total.nacks += bus->trans.nacks;
+	bus->total.ticks += bus->trans.ticks;
+	bus->total.delay += bus->trans.delay;
+	bus->total.stretch += bus->trans.stretch;
+	bus->count++;
+	if(bus->OnTrans != 0)
+		bus->OnTrans(bus, &bus->last);
+}
+
+/**
+ * SCL上升沿，从设备采样数据位，或记录ACK位
+ */
+static void _I2CHostRise(I2CHostBus * bus)
+{
+	uint8_t sda = bus->sda && !bus->slaveSda;
+
+	bus->rose = 1;
+	if(bus->state == HOST_IDLE)
+		return;
+
+	if(bus->bit < 8)
+	{
+		if(bus->state == HOST_ADDR || bus->state == HOST_WRITE)
+			bus->shift = (uint8_t)((bus->shift << 1) | sda);
+	}
+	else
+	{
+		bus->ack = !sda;
+	}
+}
+
+/**
+ * SCL下降沿，一个时钟结束，从设备输出ACK位或下一个数据位
+ */
+static void _I2CHostFall(I2CHostBus * bus)
+{
+	I2CHostSlave * slave;
+	uint8_t ack = 0;
+
+	/* Start信号之后的第一个下降沿不是时钟 */
+	if(!bus->rose || bus->state == HOST_IDLE)
+	{
+		bus->rose = 0;
+		return;
+	}
+	bus->rose = 0;
+	bus->bit++;
+
+	if(bus->bit < 8)
+	{
+		if(bus->state == HOST_READ)
+			bus->slaveSda = !((bus->shift << bus->bit) & 0x80);
+		return;
+	}
+
+	if(bus->bit == 8)
+	{
+		/* 8个数据位结束，从设备给出ACK */
+		bus->trans.bytes++;
+		slave = bus->cur;
+		switch(bus->state)
+		{
+			case HOST_ADDR:
+				slave = _I2CHostFind(bus, bus->shift >> 1);
+				if(slave != 0 && slave->ops->Start(slave, bus->shift >> 1, bus->shift & 0x01))
+					ack = 1;
+				bus->cur = ack ? slave : 0;
+				break;
+			case HOST_WRITE:
+				ack = slave->ops->Write(slave, bus->shift);
+				break;
+			case HOST_READ:
+				/* 主机给出ACK */
+				bus->slaveSda = 0;
+				return;
+			default:
+				break;
+		}
+		bus->slaveSda = ack;
+		if(!ack)
+			bus->trans.nacks++;
+		else if(slave->stretch != 0)
+			bus->sclHold = _I2CHostTime + slave->stretch;
+		return;
+	}
+
+	/* ACK位结束 */
+	bus->bit = 0;
+	bus->slaveSda = 0;
+	switch(bus->state)
+	{
+		case HOST_ADDR:
+			if(bus->cur == 0)
+				bus->state = HOST_IGNORE;
+			else
+				bus->state = (bus->shift & 0x01) ? HOST_READ : HOST_WRITE;
+			break;
+		case HOST_WRITE:
+			if(!bus->ack)
+				bus->state = HOST_IGNORE;
+			break;
+		case HOST_READ:
+			/* 主机NOACK后不再发送 */
+			if(!bus->ack)
+				bus->state = HOST_IGNORE;
+			break;
+		default:
+			break;
+	}
+	if(bus->state == HOST_READ)
+	{
+		bus->shift = bus->cur->ops->Read(bus->cur);
+		bus->slaveSda = !(bus->shift & 0x80);
+	}
+}
+
+/**
+ * 查找地址匹配的从设备
+ */
+static I2CHostSlave * _I2CHostFind(I2CHostBus * bus, uint8_t address)
+{
+	I2CHostSlave * slave;
+
+	for(slave = bus->slaves; slave != 0; slave = slave->next)
+	{
+		if(((slave->address ^ address) & ~slave->mask & 0x7F) == 0)
+			return slave;
+	}
+	return 0;
+}
+
+/* I2CBus引脚操作 */
+static void _I2CHostSclW(void * hw, uint8_t state)
+{
+	I2CHostSclWrite((I2CHostBus *)hw, state);
+}
+
+static void _I2CHostSdaW(void * hw, uint8_t state)
+{
+	I2CHostSdaWrite((I2CHostBus *)hw, state);
+}
+
+static uint8_t _I2CHostSclR(void * hw)
+{
+	return I2CHostSclRead((I2CHostBus *)hw);
+}
+
+static uint8_t _I2CHostSdaR(void * hw)
+{
+	return I2CHostSdaRead((I2CHostBus *)hw);
+}
+
+/**
+ * EEPROM：写周期内不应答；每次Start放弃未Stop的写入
+ */
+static uint8_t _I2CHostEepromStart(I2CHostSlave * slave, uint8_t address, uint8_t read)
+{
+	I2CHostEeprom * eep = (I2CHostEeprom *)slave;
+
+	if(_I2CHostTime < eep->busyUntil)
+		return 0;
+
+	eep->phase = 0;
+	eep->dirty = 0;
+	memset(eep->latched, 0, sizeof(eep->latched));
+	if(!read && eep->addrBytes == 1)
+		eep->ptr = (uint32_t)(address & slave->mask) << 8;
+	return 1;
+}
+
+/**
+ * EEPROM：先接收字地址，之后的数据存入页缓存，地址在页内回绕
+ */
+static uint8_t _I2CHostEepromWrite(I2CHostSlave * slave, uint8_t data)
+{
+	I2CHostEeprom * eep = (I2CHostEeprom *)slave;
+	uint32_t offset;
+
+	if(eep->phase < eep->addrBytes)
+	{
+		if(eep->addrBytes == 2 && eep->phase == 0)
+			eep->ptr = (uint32_t)data << 8;
+		else
+			eep->ptr = (eep->ptr & ~0xFFUL) | data;
+		eep->phase++;
+		if(eep->phase == eep->addrBytes)
+			eep->ptr %= eep->size;
+		return 1;
+	}
+
+	offset = eep->ptr % eep->page;
+	eep->latch[offset] = data;
+	eep->latched[offset] = 1;
+	eep->dirty = 1;
+	eep->ptr = eep->ptr - offset + (offset + 1) % eep->page;
+	return 1;
+}
+
+/**
+ * EEPROM：顺序读取，地址在整个存储空间内回绕
+ */
+static uint8_t _I2CHostEepromRead(I2CHostSlave * slave)
+{
+	I2CHostEeprom * eep = (I2CHostEeprom *)slave;
+	uint8_t data = eep->mem[eep->ptr];
+
+	eep->ptr = (eep->ptr + 1) % eep->size;
+	return data;
+}
+
+/**
+ * EEPROM：Stop信号后将页缓存写入存储内容，开始写周期
+ */
+static void _I2CHostEepromStop(I2CHostSlave * slave)
+{
+	I2CHostEeprom * eep = (I2CHostEeprom *)slave;
+	uint32_t base;
+	uint16_t i;
+
+	if(!eep->dirty)
+		return;
+
+	base = eep->ptr - eep->ptr % eep->page;
+	for(i = 0; i < eep->page; i++)
+	{
+		if(eep->latched[i])
+			eep->mem[base + i] = eep->latch[i];
+	}
+	eep->dirty = 0;
+	memset(eep->latched, 0, sizeof(eep->latched));
+	eep->busyUntil = _I2CHostTime + eep->writeTicks;
+	eep->writes++;
+}
+
+/**
+ * 寄存器型设备：写操作的第一个字节为寄存器地址
+ */
+static uint8_t _I2CHostRegsStart(I2CHostSlave * slave, uint8_t address, uint8_t read)
+{
+	I2CHostRegs * regs = (I2CHostRegs *)slave;
+
+	(void)address;
+	regs->first = !read;
+	return 1;
+}
+
+static uint8_t _I2CHostRegsWrite(I2CHostSlave * slave, uint8_t data)
+{
+	I2CHostRegs * regs = (I2CHostRegs *)slave;
+
+	if(regs->first)
+	{
+		regs->ptr = data;
+		regs->first = 0;
+		return 1;
+	}
+	regs->regs[regs->ptr++] = data;
+	regs->writes++;
+	return 1;
+}
+
+static uint8_t _I2CHostRegsRead(I2CHostSlave * slave)
+{
+	I2CHostRegs * regs = (I2CHostRegs *)slave;
+
+	regs->reads++;
+	return regs->regs[regs->ptr++];
+}
+
+/**
+ * XFS5152CE：写操作接收一帧，Stop后解析
+ */
+static uint8_t _I2CHostXfsStart(I2CHostSlave * slave, uint8_t address, uint8_t read)
+{
+	I2CHostXfs * xfs = (I2CHostXfs *)slave;
+
+	(void)address;
+	if(!read)
+		xfs->len = 0;
+	return 1;
+}
+
+static uint8_t _I2CHostXfsWrite(I2CHostSlave * slave, uint8_t data)
+{
+	I2CHostXfs * xfs = (I2CHostXfs *)slave;
+
+	if(xfs->len >= I2C_HOST_XFS_FRAME_MAX)
+		return 0;
+	xfs->frame[xfs->len++] = data;
+	return 1;
+}
+
+/**
+ * XFS5152CE：返回待读取的状态字节，没有时不驱动SDA，读到0xFF
+ */
+static uint8_t _I2CHostXfsRead(I2CHostSlave * slave)
+{
+	I2CHostXfs * xfs = (I2CHostXfs *)slave;
+	uint8_t reply;
+
+	if(xfs->replyNum == 0)
+		return 0xFF;
+
+	reply = xfs->reply[0];
+	xfs->replyNum--;
+	memmove(xfs->reply, xfs->reply + 1, xfs->replyNum);
+	return reply;
+}
+
+/**
+ * XFS5152CE：解析收到的帧 FD LenH LenL CMD ...
+ *   - 0x21 状态查询：返回0x4E或0x4F
+ *   - 0x01 开始合成：之后为编码格式和文本，按字符数设置合成结束时刻，返回0x41
+ *   - 0x02 停止合成、0x03 暂停、0x04 恢复：返回0x41
+ *   - 0x31 写入文本缓存：之后为起始块号（0~15，每块256字节）和文本，返回0x41
+ *   - 0x32 播放文本缓存：之后为重复次数（高4位）和编码格式，从缓存起始播放到最后一次写入的结束位置，返回0x41
+ *   - 帧格式错误或其他命令：返回0x45
+ */
+static void _I2CHostXfsStop(I2CHostSlave * slave)
+{
+	I2CHostXfs * xfs = (I2CHostXfs *)slave;
+	uint16_t n;
+
+	if(xfs->len == 0)
+		return;
+	n = xfs->len;
+	xfs->len = 0;
+
+	if(n < 4 || xfs->frame[0] != 0xFD || ((uint16_t)xfs->frame[1] << 8 | xfs->frame[2]) + 3 != n)
+	{
+		xfs->errors++;
+		_I2CHostXfsReply(xfs, 0x45);
+		return;
+	}
+
+	switch(xfs->frame[3])
+	{
+		case 0x21:
+			_I2CHostXfsReply(xfs, I2CHostXfsBusy(xfs) ? 0x4E : 0x4F);
+			break;
+		case 0x01:
+			if(n < 5)
+			{
+				xfs->errors++;
+				_I2CHostXfsReply(xfs, 0x45);
+				return;
+			}
+			xfs->text += n - 5;
+			xfs->busyUntil = _I2CHostTime + (uint64_t)xfs->charTicks * ((n - 5) / 2);
+			_I2CHostXfsReply(xfs, 0x41);
+			break;
+		case 0x02:
+			xfs->busyUntil = _I2CHostTime;
+			_I2CHostXfsReply(xfs, 0x41);
+			break;
+		case 0x03:
+		case 0x04:
+			_I2CHostXfsReply(xfs, 0x41);
+			break;
+		case 0x31:
+			if(n < 5 || xfs->frame[4] > 15 || (uint32_t)xfs->frame[4] * 256 + (n - 5) > I2C_HOST_XFS_CACHE_SIZE)
+			{
+				xfs->errors++;
+				_I2CHostXfsReply(xfs, 0x45);
+				return;
+			}
+			memcpy(xfs->cache + xfs->frame[4] * 256, xfs->frame + 5, n - 5);
+			xfs->cacheLen = (uint16_t)(xfs->frame[4] * 256 + (n - 5));
+			_I2CHostXfsReply(xfs, 0x41);
+			break;
+		case 0x32:
+			if(n != 5 || (xfs->frame[4] >> 4) == 0)
+			{
+				xfs->errors++;
+				_I2CHostXfsReply(xfs, 0x45);
+				return;
+			}
+			xfs->text += xfs->cacheLen;
+			xfs->cachePlays++;
+			xfs->busyUntil = _I2CHostTime + (uint64_t)xfs->charTicks * (xfs->cacheLen / 2) * (xfs->frame[4] >> 4);
+			_I2CHostXfsReply(xfs, 0x41);
+			break;
+		default:
+			xfs->errors++;
+			_I2CHostXfsReply(xfs, 0x45);
+			return;
+	}
+	xfs->frames++;
+}
+
+/**
+ * XFS5152CE：加入一个待读取的状态字节，已满时丢弃最早的
+ */
+static void _I2CHostXfsReply(I2CHostXfs * xfs, uint8_t reply)
+{
+	if(xfs->replyNum >= sizeof(xfs->reply))
+	{
+		xfs->replyNum--;
+		memmove(xfs->reply, xfs->reply + 1, xfs->replyNum);
+	}
+	xfs->reply[xfs->replyNum++] = reply;
+}
@@ -0,0 +1,386 @@
+/**
+ * \file
+ *
+ * \brief GPIO_I2C的Linux主机仿真底层实现
+ *
+ * \author 高明飞
+ *
+ * \date 2026-10-18
+ *
+ * \details
+ * 用软件模拟开漏总线（线与）及挂在总线上的从设备，在Linux上运行GPIO_I2C.c，
+ * 便于没有硬件时进行回归测试，并测量协议修改对总线时间的影响。\n
+ * 仿真时间以计数值为单位，只在读写引脚和读取计数器时前进（分别消耗I2C_HOST_PIN_TICKS、
+ * I2C_HOST_COUNTER_TICKS），因此结果与主机速度无关，每次运行都相同。\n
+ * 每次传输（Start到Stop）统计SCL时钟个数、字节数、无应答次数、总时间、
+ * 其中等待计数器的时间（延时）和从设备拉低SCL的时间（时钟延展），见I2CHostTrans。
+ *
+ * 从设备模型（第一个成员为I2CHostSlave，用I2CHostAttach挂到总线上）：
+ *   - I2CHostEeprom : 24Cxx EEPROM，页写入、写周期内不应答（ACK轮询）、8/16位字地址
+ *   - I2CHostRegs   : 通用寄存器型设备，第一个写入的字节为寄存器地址，之后自动递增
+ *   - I2CHostXfs    : XFS5152CE的替身，解析命令帧并返回0x4A、0x41、0x4F等状态字节，
+ *                     I2CHostXfsPin所指的替身的合成状态可作为BUSY引脚读取
+ * I2C_Parallel使用I2CHostParallelInit指定的一组仿真总线，各路共用SCL，每次端口操作同时读写各路。
+ *
+ * 编译时定义I2C_HOST，并将本目录加入头文件搜索路径，例如：
+ *   gcc -DI2C_HOST -II2C -II2C/Host -ITypeDef \
+ *       I2C/GPIO_I2C.c I2C/Host/I2C_Host.c main.c
+ *
+ * 默认总线I2CDefaultBus使用仿真总线I2CHostDefault，其他I2CBus用I2CHostBusInit连接到仿真总线。
+ *
+ * \note
+ * -需要定义I2C_DELAY_TIMER，循环延时不消耗仿真时间;\n
+ * -仿真为单线程，所有总线共用一个仿真时钟.
+ *
+ * 修改记录：\n
+ *
+ * 2026-10-18 :\n
+ *   -File Created.\n
+ *   -XFS5152CE替身没有待读取的状态字节时返回0xFF（芯片不驱动SDA），与XFS5152CE程序一致\n
+ *   -增加I2CHostXfsPin、I2CHostXfsBusyRead，供XFS5152CE程序读取BUSY引脚\n
+ *   -时钟延展期间多次释放SCL时（如主机超时后发送Stop）不重复计入时钟延展时间\n
+ *   -增加I2CHostParallel*，多路仿真总线共用SCL，供I2C_Parallel使用\n
+ *   -XFS5152CE替身支持文本缓存的写入(0x31)和播放(0x32)命令\n
+ *
+ */
+
+#ifndef I2C_HOST_H
+#define I2C_HOST_H
+
+/* 使用系统的stdint.h，TypeDef.h中只取Bool和ErrorStatus */
+#include <stdint.h>
+#define TYPE_UINT32_T
+#define TYPE_UINT16_T
+#define TYPE_UINT8_T
+#define TYPE_INT32_T
+#define TYPE_INT16_T
+#define TYPE_INT8_T
+#include "TypeDef.h"
+
+/*--------------------此部分需要修改--------------------*/
+
+/**
+ * 仿真计数器的频率(Hz)，即仿真时间的分辨率
+ */
+#define I2C_HOST_TICK_HZ 100000000UL
+
+/**
+ * 读写一次引脚消耗的仿真时间（计数值）
+ */
+#define I2C_HOST_PIN_TICKS 10
+
+/**
+ * 读取一次计数器消耗的仿真时间（计数值）
+ */
+#define I2C_HOST_COUNTER_TICKS 5
+
+/**
+ * EEPROM模型的最大页大小（字节）
+ */
+#define I2C_HOST_EEPROM_PAGE_MAX 256
+
+/**
+ * XFS5152CE模型的最大帧长度（字节）
+ */
+#define I2C_HOST_XFS_FRAME_MAX 4096
+
+/**
+ * XFS5152CE模型的文本缓存大小（字节），16块，每块256字节
+ */
+#define I2C_HOST_XFS_CACHE_SIZE 4096
+
+/*--------------------此部分需要修改--------------------*/
+
+struct I2CHostBus_t;
+struct I2CHostSlave_t;
+struct I2CBus_t;
+
+/** 从设备模型的操作，均在仿真总线的SCL边沿或Start、Stop信号处调用 */
+typedef struct
+{
+	/** 地址匹配，read为读写位，返回1时应答 */
+	uint8_t (*Start)(struct I2CHostSlave_t * slave, uint8_t address, uint8_t read);
+	/** 收到一个数据字节，返回1时应答 */
+	uint8_t (*Write)(struct I2CHostSlave_t * slave, uint8_t data);
+	/** 返回下一个发送给主机的字节 */
+	uint8_t (*Read)(struct I2CHostSlave_t * slave);
+	/** 本次寻址后的Stop信号，可以为空 */
+	void (*Stop)(struct I2CHostSlave_t * slave);
+} I2CHostSlaveOps;
+
+/** 从设备，作为从设备模型的第一个成员 */
+typedef struct I2CHostSlave_t
+{
+	uint8_t address;                /**< 7位地址 */
+	uint8_t mask;                   /**< 地址中由模型解释的位（如24C04~24C16的块地址），不参与匹配 */
+	uint32_t stretch;               /**< 每个字节的ACK位前拉低SCL的时间（计数值），0为不延展 */
+	const I2CHostSlaveOps * ops;    /**< 模型的操作 */
+	struct I2CHostSlave_t * next;   /**< 同一总线上的下一个从设备 */
+} I2CHostSlave;
+
+/** 一次传输（Start到Stop）的统计信息，时间单位为计数值 */
+typedef struct
+{
+	uint32_t cycles;   /**< SCL时钟个数，含重复Start和Stop */
+	uint32_t bytes;    /**< 字节数，含地址字节 */
+	uint32_t nacks;    /**< 从设备无应答的字节数 */
+	uint32_t ticks;    /**< 总时间 */
+	uint32_t delay;    /**< 其中等待计数器的时间（延时及等待时钟延展） */
+	uint32_t stretch;  /**< 其中从设备拉低SCL的时间 */
+} I2CHostTrans;
+
+/** 仿真总线 */
+typedef struct I2CHostBus_t
+{
+	uint8_t scl;                    /**< 主机SCL输出，1为释放 */
+	uint8_t sda;                    /**< 主机SDA输出，1为释放 */
+	uint8_t slaveSda;               /**< 从设备拉低SDA */
+	uint64_t sclHold;               /**< 从设备拉低SCL直到此时刻 */
+	uint64_t stretchEnd;            /**< 已计入统计的时钟延展的结束时刻，同一次延展中多次释放SCL只计一次 */
+	uint8_t state;                  /**< 协议状态 */
+	uint8_t bit;                    /**< 当前字节已完成的时钟个数 */
+	uint8_t rose;                   /**< 上一个SCL边沿为上升沿 */
+	uint8_t shift;                  /**< 移位寄存器 */
+	uint8_t ack;                    /**< 当前字节的ACK位 */
+	I2CHostSlave * slaves;          /**< 从设备链表 */
+	I2CHostSlave * cur;             /**< 本次寻址的从设备 */
+	uint8_t busy;                   /**< Start与Stop之间 */
+	uint64_t start;                 /**< 本次传输的开始时刻 */
+	uint64_t delayStart;            /**< 本次传输开始时的计数器等待时间 */
+	I2CHostTrans trans;             /**< 进行中的传输 */
+	I2CHostTrans last;              /**< 上一次完成的传输 */
+	I2CHostTrans total;             /**< 所有完成的传输之和 */
+	uint32_t count;                 /**< 完成的传输次数 */
+	/** 每次传输完成时调用，可以为空 */
+	void (*OnTrans)(struct I2CHostBus_t * bus, const I2CHostTrans * trans);
+} I2CHostBus;
+
+/** 24Cxx EEPROM模型 */
+typedef struct
+{
+	I2CHostSlave slave;                          /**< 从设备，必须为第一个成员 */
+	uint8_t * mem;                               /**< 存储内容 */
+	uint32_t size;                               /**< 容量（字节） */
+	uint16_t page;                               /**< 页大小（字节） */
+	uint8_t addrBytes;                           /**< 字地址字节数，1或2 */
+	uint32_t writeTicks;                         /**< 写周期时间tWR（计数值） */
+	uint64_t busyUntil;                          /**< 写周期结束时刻，之前不应答 */
+	uint32_t ptr;                                /**< 当前地址 */
+	uint8_t phase;                               /**< 写操作中已收到的字地址字节数 */
+	uint8_t latch[I2C_HOST_EEPROM_PAGE_MAX];     /**< 页缓存 */
+	uint8_t latched[I2C_HOST_EEPROM_PAGE_MAX];   /**< 页缓存中已写入的字节 */
+	uint8_t dirty;                               /**< 页缓存中有数据 */
+	uint32_t writes;                             /**< 写周期次数 */
+} I2CHostEeprom;
+
+/** 通用寄存器型设备模型 */
+typedef struct
+{
+	I2CHostSlave slave;   /**< 从设备，必须为第一个成员 */
+	uint8_t regs[256];    /**< 寄存器 */
+	uint8_t ptr;          /**< 寄存器地址 */
+	uint8_t first;        /**< 下一个写入的字节为寄存器地址 */
+	uint32_t writes;      /**< 写入的寄存器个数 */
+	uint32_t reads;       /**< 读取的寄存器个数 */
+} I2CHostRegs;
+
+/** XFS5152CE替身模型 */
+typedef struct
+{
+	I2CHostSlave slave;                      /**< 从设备，必须为第一个成员 */
+	uint8_t frame[I2C_HOST_XFS_FRAME_MAX];   /**< 本次写入的帧 */
+	uint16_t len;                            /**< 本次写入的字节数 */
+	uint8_t reply[8];                        /**< 待读取的状态字节 */
+	uint8_t replyNum;                        /**< 待读取的状态字节数 */
+	uint32_t charTicks;                      /**< 合成每个字符（2字节）的时间（计数值） */
+	uint64_t busyUntil;                      /**< 合成结束时刻 */
+	uint32_t frames;                         /**< 收到的正确帧数 */
+	uint32_t errors;                         /**< 收到的错误帧数 */
+	uint32_t text;                           /**< 收到的合成文本字节数，播放文本缓存时计入缓存中的文本 */
+	uint8_t cache[I2C_HOST_XFS_CACHE_SIZE];  /**< 文本缓存 */
+	uint16_t cacheLen;                       /**< 文本缓存中的字节数，到最后一次写入的结束位置 */
+	uint32_t cachePlays;                     /**< 播放文本缓存的次数 */
+} I2CHostXfs;
+
+/** 默认总线使用的仿真总线 */
+extern I2CHostBus I2CHostDefault;
+
+/** BUSY引脚连接的XFS5152CE替身，为0时BUSY引脚为低电平 */
+extern I2CHostXfs * I2CHostXfsPin;
+
+/* 默认总线的HAL宏定义 */
+#define HAL_SCL_W(STATE)  I2CHostSclWrite(&I2CHostDefault, (uint8_t)(STATE))
+#define HAL_SDA_W(STATE)  I2CHostSdaWrite(&I2CHostDefault, (uint8_t)(STATE))
+#define HAL_SCL_R         (I2CHostSclRead(&I2CHostDefault))
+#define HAL_SDA_R         (I2CHostSdaRead(&I2CHostDefault))
+#define HAL_I2C_TICKS()   ((uint16_t)I2CHostTicks())
+#define HAL_I2C_TICK_HZ   I2C_HOST_TICK_HZ
+#define HAL_I2C_STATS_TIME() ((uint32_t)(I2CHostNow() / (I2C_HOST_TICK_HZ / 1000000UL)))  /* 仿真时间(us) */
+#define HAL_I2C_STATS_TIME_HZ 1000000UL
+
+
+/**
+ * 初始化仿真总线，释放SCL、SDA，清除从设备和统计信息
+ *
+ * \param bus : 仿真总线指针
+ *
+ */
+void I2CHostInit(I2CHostBus * bus);
+
+
+/**
+ * 初始化连接到仿真总线的I2CBus总线对象
+ *
+ * \param i2c : I2CBus总线对象指针
+ * \param bus : 已初始化的仿真总线
+ *
+ */
+void I2CHostBusInit(struct I2CBus_t * i2c, I2CHostBus * bus);
+
+
+/**
+ * 将从设备挂到仿真总线上
+ *
+ * \param bus   : 仿真总线指针
+ * \param slave : 已初始化的从设备模型的slave成员
+ *
+ */
+void I2CHostAttach(I2CHostBus * bus, I2CHostSlave * slave);
+
+
+/**
+ * 清除仿真总线的统计信息
+ *
+ * \param bus : 仿真总线指针
+ *
+ */
+void I2CHostResetStats(I2CHostBus * bus);
+
+
+/**
+ * 返回当前仿真时间（计数值）
+ *
+ */
+uint64_t I2CHostNow(void);
+
+
+/**
+ * 仿真时间前进，用于模拟主程序中的其他操作
+ *
+ * \param ticks : 前进的时间（计数值）
+ *
+ */
+void I2CHostAdvance(uint32_t ticks);
+
+
+/**
+ * 读取计数器，消耗I2C_HOST_COUNTER_TICKS，计入传输中的延时时间
+ *
+ * \return 仿真时间的低32位
+ *
+ */
+uint32_t I2CHostTicks(void);
+
+
+/**
+ * 主机SCL、SDA输出，1为释放，0为拉低
+ *
+ * \param bus   : 仿真总线指针
+ * \param state : 输出电平
+ *
+ */
+void I2CHostSclWrite(I2CHostBus * bus, uint8_t state);
+void I2CHostSdaWrite(I2CHostBus * bus, uint8_t state);
+
+
+/**
+ * 读取SCL、SDA的实际电平（主机与从设备输出的线与）
+ *
+ * \param bus : 仿真总线指针
+ *
+ * \return 电平，0或1
+ *
+ */
+uint8_t I2CHostSclRead(I2CHostBus * bus);
+uint8_t I2CHostSdaRead(I2CHostBus * bus);
+
+
+/**
+ * 设置I2C_Parallel使用的仿真总线组，第b路总线的SDA为端口的第b位，各路共用SCL
+ *
+ * \param buses : 已初始化的仿真总线数组
+ * \param num   : 总线个数，1~8
+ *
+ */
+void I2CHostParallelInit(I2CHostBus * buses, uint8_t num);
+
+
+/**
+ * I2C_Parallel的端口操作，每次消耗一次引脚操作的仿真时间：
+ * 同时写各路的SCL、SDA（bits的第b位为第b路的SDA电平），
+ * 读取共用的SCL（任何一路的从设备拉低时为0），同时读取各路的SDA（没有总线的位为1）
+ *
+ */
+void I2CHostParallelSclWrite(uint8_t state);
+void I2CHostParallelSdaWrite(uint8_t bits);
+uint8_t I2CHostParallelSclRead(void);
+uint8_t I2CHostParallelSdaRead(void);
+
+
+/**
+ * 初始化24Cxx EEPROM模型
+ *
+ * \param eep        : 模型指针
+ * \param address    : 7位地址，如0x50，addrBytes为1且容量大于256字节时低位为块地址
+ * \param mem        : 存储内容，size字节
+ * \param size       : 容量（字节），如24C02为256，24C256为32768
+ * \param page       : 页大小（字节），不大于I2C_HOST_EEPROM_PAGE_MAX
+ * \param addrBytes  : 字地址字节数，24C01~24C16为1，24C32及以上为2
+ * \param writeTicks : 写周期时间tWR（计数值），如5ms
+ *
+ */
+void I2CHostEepromInit(I2CHostEeprom * eep, uint8_t address, uint8_t * mem, uint32_t size,
+                       uint16_t page, uint8_t addrBytes, uint32_t writeTicks);
+
+
+/**
+ * 初始化通用寄存器型设备模型，寄存器清零
+ *
+ * \param regs    : 模型指针
+ * \param address : 7位地址
+ *
+ */
+void I2CHostRegsInit(I2CHostRegs * regs, uint8_t address);
+
+
+/**
+ * 初始化XFS5152CE替身模型，上电后第一次读取返回0x4A
+ *
+ * \param xfs       : 模型指针
+ * \param address   : 7位地址，一般为0x40
+ * \param charTicks : 合成每个字符的时间（计数值）
+ *
+ */
+void I2CHostXfsInit(I2CHostXfs * xfs, uint8_t address, uint32_t charTicks);
+
+
+/**
+ * 查询XFS5152CE替身是否正在合成，相当于读取BUSY引脚
+ *
+ * \param xfs : 模型指针
+ *
+ * \return 正在合成时返回1，否则返回0
+ *
+ */
+uint8_t I2CHostXfsBusy(I2CHostXfs * xfs);
+
+
+/**
+ * 读取I2CHostXfsPin的BUSY引脚，消耗一次引脚操作的仿真时间
+ *
+ * \return 正在合成时返回1，否则返回0
+ *
+ */
+uint8_t I2CHostXfsBusyRead(void);
+
+#endif
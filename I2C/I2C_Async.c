@@ -0,0 +1,372 @@
+/**
+ * \file
+ *
+ * \brief 定时器中断驱动的异步GPIO模拟I2C程序
+ *
+ * \author 高明飞
+ *
+ * \date 2026-10-18
+ *
+ * \details
+ * 每次定时器中断执行状态机的一步，每一步改变一次SCL电平：
+ *   - 低电平步：拉低SCL，然后输出SDA（数据位、ACK位或释放SDA）
+ *   - 高电平步：释放SCL
+ * 释放SCL后的下一步先检查SCL是否已变为高电平，从设备时钟延展时本次中断直接返回，
+ * 然后读取SDA（数据位或ACK位），即在SCL高电平结束前采样。
+ *
+ * 修改记录：\n
+ *
+ * 2026-10-18 :\n
+ *   -File Created.\n
+ *   -时钟延展等待计数改为16位，I2C_ASYNC_STRETCH_TICKS超出范围时编译报错\n
+ *
+ */
+
+#include "I2C_Async.h"
+
+#if I2C_ASYNC_STRETCH_TICKS < 1 || I2C_ASYNC_STRETCH_TICKS > 65535
+#error "I2C_ASYNC_STRETCH_TICKS必须在1~65535之间"
+#endif
+
+/* 状态机的步骤 */
+#define STEP_IDLE         0  /* 空闲 */
+#define STEP_START        1  /* SCL、SDA为高电平，拉低SDA产生Start信号 */
+#define STEP_LOW          2  /* 拉低SCL，输出SDA */
+#define STEP_HIGH         3  /* 释放SCL */
+#define STEP_ACK          4  /* 一个字节（含ACK位）结束 */
+#define STEP_RESTART_HIGH 5  /* 重复Start：SDA为高电平时释放SCL */
+#define STEP_STOP         6  /* 拉低SCL和SDA */
+#define STEP_STOP_HIGH    7  /* 释放SCL */
+#define STEP_STOP_END     8  /* 释放SDA产生Stop信号，传输结束 */
+
+/* 传输的阶段 */
+#define PHASE_ADDR_W 0  /* 发送写地址 */
+#define PHASE_WRITE  1  /* 写数据 */
+#define PHASE_ADDR_R 2  /* 发送读地址 */
+#define PHASE_READ   3  /* 读数据 */
+
+/* 传输队列，队首为正在传输的描述符 */
+static I2CAsyncTrans * _I2CAsyncHead;
+static I2CAsyncTrans * _I2CAsyncTail;
+
+/* 状态机 */
+static uint8_t _I2CAsyncStep = STEP_IDLE;
+static uint8_t _I2CAsyncPhase;
+static uint8_t _I2CAsyncIndex;    /* 本阶段已传输的字节数 */
+static uint8_t _I2CAsyncByte;     /* 正在发送或接收的字节 */
+static uint8_t _I2CAsyncBit;      /* 下一个输出的位，0~7为数据位，8为ACK位 */
+static uint8_t _I2CAsyncRead;     /* 当前字节为读取 */
+static uint8_t _I2CAsyncSclHigh;  /* 上一步释放了SCL */
+static uint16_t _I2CAsyncStretch; /* 时钟延展已等待的中断次数 */
+static uint8_t _I2CAsyncError;    /* 从设备无应答或时钟延展超时 */
+
+/* 内部使用的函数声明 */
+static void _I2CAsyncLoad(uint8_t phase);
+static void _I2CAsyncLow(void);
+static void _I2CAsyncStop(void);
+static void _I2CAsyncNext(uint8_t sda);
+static void _I2CAsyncFinish(void);
+
+/**
+ * 填写传输描述符
+ *
+ * \param trans    : 传输描述符指针
+ * \param address  : 从设备地址
+ * \param wrData   : 写入的数据
+ * \param wrCount  : 写入的字节数，可以为0
+ * \param rdData   : 读取结果存放位置
+ * \param rdCount  : 读取的字节数，可以为0
+ * \param callback : 完成回调函数，可以为空
+ *
+ */
+void I2CAsyncSetup(I2CAsyncTrans * trans, uint8_t address, uint8_t * wrData, uint8_t wrCount,
+                   uint8_t * rdData, uint8_t rdCount, void (*callback)(I2CAsyncTrans * trans))
+{
+	trans->address = address;
+	trans->wrData = wrData;
+	trans->wrCount = wrCount;
+	trans->rdData = rdData;
+	trans->rdCount = rdCount;
+	trans->callback = callback;
+	trans->state = I2C_ASYNC_IDLE;
+	trans->next = 0;
+}
+
+
+/**
+ * 提交传输，加入传输队列后立即返回
+ *
+ * \param trans : 传输描述符指针，传输完成前不能修改
+ *
+ * \return 执行结果
+ * \retval I2COK    : 成功
+ * \retval I2CERROR : 读写字节数都为0，或描述符已在队列中
+ *
+ */
+I2CResult I2CAsyncSubmit(I2CAsyncTrans * trans)
+{
+	if((trans->wrCount == 0 && trans->rdCount == 0)
+	   || trans->state == I2C_ASYNC_PENDING || trans->state == I2C_ASYNC_BUSY)
+		return I2CERROR;
+
+	trans->state = I2C_ASYNC_PENDING;
+	trans->next = 0;
+
+	HAL_I2C_ASYNC_LOCK();
+	if(_I2CAsyncHead == 0)
+		_I2CAsyncHead = trans;
+	else
+		_I2CAsyncTail->next = trans;
+	_I2CAsyncTail = trans;
+	HAL_I2C_ASYNC_UNLOCK();
+
+	return I2COK;
+}
+
+
+/**
+ * 查询是否有未完成的传输
+ *
+ * \return 未完成时返回1，否则返回0
+ *
+ */
+uint8_t I2CAsyncBusy(void)
+{
+	return _I2CAsyncHead != 0;
+}
+
+
+/**
+ * 在周期定时器中断中调用，每次前进半位
+ *
+ */
+void I2CAsyncISR(void)
+{
+	uint8_t sda = 1;
+
+	if(_I2CAsyncStep == STEP_IDLE)
+	{
+		if(_I2CAsyncHead == 0)
+			return;
+		_I2CAsyncHead->state = I2C_ASYNC_BUSY;
+		_I2CAsyncError = 0;
+		_I2CAsyncPhase = _I2CAsyncHead->wrCount != 0 ? PHASE_ADDR_W : PHASE_ADDR_R;
+		_I2CAsyncStep = STEP_START;
+	}
+
+	/* 上一步释放了SCL：等待时钟延展结束，在拉低SCL之前读取SDA */
+	if(_I2CAsyncSclHigh)
+	{
+		if(HAL_SCL_R == 0 && !_I2CAsyncError)
+		{
+			if(++_I2CAsyncStretch < I2C_ASYNC_STRETCH_TICKS)
+				return;
+			/* 超时后结束传输，之后不再等待 */
+			_I2CAsyncError = 1;
+			_I2CAsyncStep = STEP_STOP;
+		}
+		_I2CAsyncSclHigh = 0;
+		_I2CAsyncStretch = 0;
+		sda = HAL_SDA_R;
+	}
+
+	switch(_I2CAsyncStep)
+	{
+		case STEP_START:
+			HAL_SDA_W(0);
+			_I2CAsyncLoad(_I2CAsyncPhase);
+			_I2CAsyncStep = STEP_LOW;
+			break;
+
+		case STEP_LOW:
+			/* 读取上一个数据位 */
+			if(_I2CAsyncRead && _I2CAsyncBit != 0)
+				_I2CAsyncByte = (_I2CAsyncByte << 1) | (sda & 0x01);
+			_I2CAsyncLow();
+			break;
+
+		case STEP_HIGH:
+			HAL_SCL_W(1);
+			_I2CAsyncSclHigh = 1;
+			_I2CAsyncBit++;
+			_I2CAsyncStep = _I2CAsyncBit > 8 ? STEP_ACK : STEP_LOW;
+			break;
+
+		case STEP_ACK:
+			_I2CAsyncNext(sda);
+			break;
+
+		case STEP_RESTART_HIGH:
+			HAL_SCL_W(1);
+			_I2CAsyncSclHigh = 1;
+			_I2CAsyncStep = STEP_START;
+			break;
+
+		case STEP_STOP:
+			_I2CAsyncStop();
+			break;
+
+		case STEP_STOP_HIGH:
+			HAL_SCL_W(1);
+			_I2CAsyncSclHigh = 1;
+			_I2CAsyncStep = STEP_STOP_END;
+			break;
+
+		case STEP_STOP_END:
+			HAL_SDA_W(1);
+			_I2CAsyncFinish();
+			break;
+
+		default:
+			_I2CAsyncStep = STEP_IDLE;
+			break;
+	}
+}
+
+
+/**
+ * 开始传输某一阶段的一个字节
+ */
+static void _I2CAsyncLoad(uint8_t phase)
+{
+	I2CAsyncTrans * trans = _I2CAsyncHead;
+
+	_I2CAsyncPhase = phase;
+	_I2CAsyncBit = 0;
+	_I2CAsyncRead = 0;
+	switch(phase)
+	{
+		case PHASE_ADDR_W:
+			_I2CAsyncByte = trans->address << 1;
+			break;
+		case PHASE_WRITE:
+			_I2CAsyncByte = trans->wrData[_I2CAsyncIndex];
+			break;
+		case PHASE_ADDR_R:
+			_I2CAsyncByte = (trans->address << 1) | 0x01;
+			break;
+		default:
+			_I2CAsyncByte = 0;
+			_I2CAsyncRead = 1;
+			break;
+	}
+}
+
+/**
+ * 低电平步：拉低SCL后输出SDA
+ */
+static void _I2CAsyncLow(void)
+{
+	HAL_SCL_W(0);
+	if(_I2CAsyncBit < 8)
+	{
+		/* 读取时释放SDA */
+		if(_I2CAsyncRead)
+		{
+			HAL_SDA_W(1);
+		}
+		else
+		{
+			HAL_SDA_W(_I2CAsyncByte >> 7);
+			_I2CAsyncByte <<= 1;
+		}
+	}
+	else
+	{
+		/* ACK位：写时释放SDA由从设备应答，读时除最后一个字节外发送ACK */
+		HAL_SDA_W(_I2CAsyncRead && _I2CAsyncIndex + 1 < _I2CAsyncHead->rdCount ? 0 : 1);
+	}
+	_I2CAsyncStep = STEP_HIGH;
+}
+
+/**
+ * 拉低SCL和SDA，开始Stop信号
+ */
+static void _I2CAsyncStop(void)
+{
+	HAL_SCL_W(0);
+	HAL_SDA_W(0);
+	_I2CAsyncStep = STEP_STOP_HIGH;
+}
+
+/**
+ * 一个字节结束，sda为ACK位的电平，决定下一个字节、重复Start或Stop
+ */
+static void _I2CAsyncNext(uint8_t sda)
+{
+	I2CAsyncTrans * trans = _I2CAsyncHead;
+
+	if(!_I2CAsyncRead && sda)
+	{
+		/* 从设备无应答 */
+		_I2CAsyncError = 1;
+		_I2CAsyncStop();
+		return;
+	}
+
+	switch(_I2CAsyncPhase)
+	{
+		case PHASE_ADDR_W:
+			_I2CAsyncIndex = 0;
+			_I2CAsyncLoad(PHASE_WRITE);
+			_I2CAsyncLow();
+			return;
+
+		case PHASE_WRITE:
+			_I2CAsyncIndex++;
+			if(_I2CAsyncIndex < trans->wrCount)
+			{
+				_I2CAsyncLoad(PHASE_WRITE);
+				_I2CAsyncLow();
+			}
+			else if(trans->rdCount != 0)
+			{
+				/* 重复Start：SCL为低电平时释放SDA，之后释放SCL，再拉低SDA */
+				HAL_SCL_W(0);
+				HAL_SDA_W(1);
+				_I2CAsyncPhase = PHASE_ADDR_R;
+				_I2CAsyncStep = STEP_RESTART_HIGH;
+			}
+			else
+			{
+				_I2CAsyncStop();
+			}
+			return;
+
+		case PHASE_ADDR_R:
+			_I2CAsyncIndex = 0;
+			_I2CAsyncLoad(PHASE_READ);
+			_I2CAsyncLow();
+			return;
+
+		default:
+			trans->rdData[_I2CAsyncIndex] = _I2CAsyncByte;
+			_I2CAsyncIndex++;
+			if(_I2CAsyncIndex < trans->rdCount)
+			{
+				_I2CAsyncLoad(PHASE_READ);
+				_I2CAsyncLow();
+			}
+			else
+			{
+				_I2CAsyncStop();
+			}
+			return;
+	}
+}
+
+/**
+ * 传输结束，从队列中取出描述符并调用回调函数
+ */
+static void _I2CAsyncFinish(void)
+{
+	I2CAsyncTrans * trans = _I2CAsyncHead;
+
+	/* 先出队，回调函数中可以再次提交 */
+	_I2CAsyncHead = trans->next;
+	_I2CAsyncStep = STEP_IDLE;
+	trans->state = _I2CAsyncError ? I2C_ASYNC_ERROR : I2C_ASYNC_DONE;
+
+	if(trans->callback != 0)
+		trans->callback(trans);
+}
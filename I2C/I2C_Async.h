@@ -0,0 +1,145 @@
+/**
+ * \file
+ *
+ * \brief 定时器中断驱动的异步GPIO模拟I2C程序
+ *
+ * \author 高明飞
+ *
+ * \date 2026-10-18
+ *
+ * \details
+ * GPIO_I2C.h中的I2CWrite*、I2CRead*函数在整个传输过程中占用CPU，
+ * 例如XFS5152CE_Start发送一帧约需2ms。本模块将传输过程拆成状态机，
+ * 周期定时器中断中每调用一次I2CAsyncISR前进半位（SCL的一个电平），
+ * 主循环提交传输描述符后即可继续运行，传输完成后调用回调函数并设置描述符的状态。\n
+ * 定时器中断的频率为SCL频率的2倍，例如20kHz的中断对应10kHz的SCL。\n
+ * 每个传输描述符先写wrCount个字节，再读rdCount个字节，两者都不为0时之间使用重复Start，
+ * 可以实现GPIO_I2C.h中的所有读写操作：
+ *   - I2CWriteReg    : wrData = {reg, data}，rdCount = 0
+ *   - I2CReadRegs    : wrData = {reg}，rdData = 读取结果
+ *   - I2CReadMultiBytes : wrCount = 0
+ *
+ * 使用方法：
+ *   static I2CAsyncTrans Trans;
+ *   static uint8_t Reg = 0x20, Buf[6];
+ *
+ *   定时器中断中：I2CAsyncISR();
+ *   I2CAsyncSetup(&Trans, 0x50, &Reg, 1, Buf, 6, OnDone);
+ *   I2CAsyncSubmit(&Trans);
+ *   ...
+ *   if(Trans.state == I2C_ASYNC_DONE) { 使用Buf }
+ *
+ * \note
+ * -使用GPIO_I2C.h中定义的SCL、SDA引脚，异步传输进行中不能调用GPIO_I2C.h中的函数;\n
+ * -回调函数在定时器中断中执行，应尽量简短，可以在其中提交新的传输.
+ *
+ * 修改记录：\n
+ *
+ * 2026-10-18 :\n
+ *   -File Created.\n
+ *   -示例改为使用STC15的定时器2，增加I2C_HOST时的HAL宏定义\n
+ *   -时钟延展等待计数改为16位，I2C_ASYNC_STRETCH_TICKS超出范围时编译报错\n
+ *
+ */
+
+#ifndef I2C_ASYNC_H
+#define I2C_ASYNC_H
+
+/* SCL、SDA引脚及I2CResult的定义 */
+#include "GPIO_I2C.h"
+
+/*--------------------此部分需要修改--------------------*/
+
+#ifdef I2C_HOST
+/* Linux主机仿真环境，I2CAsyncISR由仿真程序在主循环中调用，不需要禁止中断 */
+#define HAL_I2C_ASYNC_LOCK()   ((void)0)
+#define HAL_I2C_ASYNC_UNLOCK() ((void)0)
+#else
+/**
+ * 禁止定时器中断，提交传输时保护传输队列。此处以STC15的定时器2为例（IE2的ET2位），
+ * 定时器0已用作GPIO_I2C.h中HAL_I2C_TICKS()的自由运行计数器，不能用于本模块
+ */
+#define HAL_I2C_ASYNC_LOCK() (IE2 &= ~0x04)
+
+/**
+ * 允许定时器中断
+ */
+#define HAL_I2C_ASYNC_UNLOCK() (IE2 |= 0x04)
+#endif
+
+/**
+ * 从设备时钟延展（拉低SCL）的最长等待时间，单位为定时器中断次数，1~65535，超时后传输失败
+ */
+#define I2C_ASYNC_STRETCH_TICKS 200
+
+/*--------------------此部分需要修改--------------------*/
+
+/** 传输状态枚举定义 */
+typedef enum
+{
+	I2C_ASYNC_IDLE,     /**< 未提交 */
+	I2C_ASYNC_PENDING,  /**< 已提交，等待前面的传输完成 */
+	I2C_ASYNC_BUSY,     /**< 正在传输 */
+	I2C_ASYNC_DONE,     /**< 传输完成 */
+	I2C_ASYNC_ERROR     /**< 从设备无应答或时钟延展超时 */
+} I2CAsyncState;
+
+/** 传输描述符 */
+typedef struct I2CAsyncTrans_t
+{
+	uint8_t address;                                /**< 从设备地址 */
+	uint8_t wrCount;                                /**< 写入的字节数 */
+	uint8_t rdCount;                                /**< 读取的字节数 */
+	uint8_t * wrData;                               /**< 写入的数据 */
+	uint8_t * rdData;                               /**< 读取结果存放位置 */
+	void (*callback)(struct I2CAsyncTrans_t * trans);  /**< 完成回调函数，可以为空 */
+	volatile I2CAsyncState state;                   /**< 传输状态 */
+	struct I2CAsyncTrans_t * next;                  /**< 传输队列中的下一个描述符 */
+} I2CAsyncTrans;
+
+
+/**
+ * 填写传输描述符
+ *
+ * \param trans    : 传输描述符指针
+ * \param address  : 从设备地址
+ * \param wrData   : 写入的数据
+ * \param wrCount  : 写入的字节数，可以为0
+ * \param rdData   : 读取结果存放位置
+ * \param rdCount  : 读取的字节数，可以为0
+ * \param callback : 完成回调函数，可以为空
+ *
+ */
+void I2CAsyncSetup(I2CAsyncTrans * trans, uint8_t address, uint8_t * wrData, uint8_t wrCount,
+                   uint8_t * rdData, uint8_t rdCount, void (*callback)(I2CAsyncTrans * trans));
+
+
+/**
+ * 提交传输，加入传输队列后立即返回
+ *
+ * \param trans : 传输描述符指针，传输完成前不能修改
+ *
+ * \return 执行结果
+ * \retval I2COK    : 成功
+ * \retval I2CERROR : 读写字节数都为0，或描述符已在队列中
+ *
+ */
+I2CResult I2CAsyncSubmit(I2CAsyncTrans * trans);
+
+
+/**
+ * 查询是否有未完成的传输
+ *
+ * \return 未完成时返回1，否则返回0
+ *
+ */
+uint8_t I2CAsyncBusy(void);
+
+
+/**
+ * 在周期定时器中断中调用，每次前进半位
+ *
+ */
+void I2CAsyncISR(void);
+
+#endif
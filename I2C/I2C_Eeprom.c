@@ -0,0 +1,189 @@
+/**
+ * \file
+ *
+ * \brief 24Cxx系列I2C EEPROM读写程序
+ *
+ * \author 高明飞
+ *
+ * \date 2026-10-18
+ *
+ * \details
+ * ACK轮询直接使用要执行的传输：传输失败（写周期内地址无应答）时重新发送，
+ * 失败的传输只有Start、地址字节和Stop信号，第一次成功时即已完成写入或设置地址。
+ * 读取时先发送字地址（不带数据，不会开始写周期），之后用当前地址读取分段连续读出。
+ *
+ * 修改记录：\n
+ *
+ * 2026-10-18 :\n
+ *   -File Created.\n
+ *
+ */
+
+#include "I2C_Eeprom.h"
+
+/* 等待超时的计数值 */
+#define I2C_EEPROM_TIMEOUT_TICKS (HAL_I2C_TICK_HZ / 1000UL * I2C_EEPROM_TIMEOUT)
+
+/* 内部使用的函数声明 */
+static I2CResult _I2CEepromSend(I2CEeprom * eep, uint32_t addr, const uint8_t * I2Cdata, uint16_t count);
+
+/**
+ * 初始化EEPROM对象
+ *
+ * \param eep       : EEPROM对象指针
+ * \param bus       : 所在的总线，如&I2CDefaultBus
+ * \param address   : 7位地址，如0x50
+ * \param size      : 容量（字节），如24C02为256，24C256为32768
+ * \param page      : 页大小（字节），如24C02为8，24C256为64
+ * \param addrBytes : 字地址字节数，24C01~24C16为1，24C32及以上为2
+ *
+ */
+void I2CEepromInit(I2CEeprom * eep, I2CBus * bus, uint8_t address, uint32_t size, uint16_t page, uint8_t addrBytes)
+{
+	eep->bus = bus;
+	eep->address = address;
+	eep->size = size;
+	eep->page = page;
+	eep->addrBytes = addrBytes;
+}
+
+
+/**
+ * 写入数据，按页边界拆分，每页一次传输，写周期内ACK轮询
+ *
+ * \param eep     : EEPROM对象指针
+ * \param addr    : 起始地址
+ * \param I2Cdata : 写入的数据
+ * \param count   : 数据长度
+ *
+ * \return 执行结果
+ * \retval I2COK    : 成功
+ * \retval I2CERROR : 超出容量，或等待超时，此时之前的页已写入
+ *
+ */
+I2CResult I2CEepromWrite(I2CEeprom * eep, uint32_t addr, const uint8_t I2Cdata[], uint16_t count)
+{
+	uint16_t n;
+
+	if(addr + count > eep->size)
+		return I2CERROR;
+
+	while(count != 0)
+	{
+		/* 写到本页末尾为止，超出部分会回绕到页首 */
+		n = eep->page - (uint16_t)(addr % eep->page);
+		if(n > count)
+			n = count;
+		if(_I2CEepromSend(eep, addr, I2Cdata, n) != I2COK)
+			return I2CERROR;
+		addr += n;
+		I2Cdata += n;
+		count -= n;
+	}
+	return I2COK;
+}
+
+
+/**
+ * 读取数据，正在写周期时先等待
+ *
+ * \param eep     : EEPROM对象指针
+ * \param addr    : 起始地址
+ * \param I2Cdata : 读取结果存放数组
+ * \param count   : 数据长度
+ *
+ * \return 执行结果
+ * \retval I2COK    : 成功
+ * \retval I2CERROR : 超出容量，或等待超时
+ *
+ */
+I2CResult I2CEepromRead(I2CEeprom * eep, uint32_t addr, uint8_t I2Cdata[], uint16_t count)
+{
+	uint8_t n;
+
+	if(addr + count > eep->size)
+		return I2CERROR;
+	if(count == 0)
+		return I2COK;
+
+	/* 设置地址，之后从当前地址连续读取，地址由EEPROM自动递增 */
+	if(_I2CEepromSend(eep, addr, 0, 0) != I2COK)
+		return I2CERROR;
+	while(count != 0)
+	{
+		n = count > 0xFF ? 0xFF : (uint8_t)count;
+		if(I2CBusReadMultiBytes(eep->bus, eep->address, n, I2Cdata) != I2COK)
+			return I2CERROR;
+		I2Cdata += n;
+		count -= n;
+	}
+	return I2COK;
+}
+
+
+/**
+ * 等待写周期结束
+ *
+ * \param eep : EEPROM对象指针
+ *
+ * \return 执行结果
+ * \retval I2COK    : 成功
+ * \retval I2CERROR : 等待超时
+ *
+ */
+I2CResult I2CEepromWait(I2CEeprom * eep)
+{
+	uint16_t t0, t1;
+	uint32_t wait = 0;
+
+	eep->bus->polling = 1;
+	t0 = HAL_I2C_TICKS();
+	while(I2CBusWriteBlock(eep->bus, eep->address, 0, 0, 0, 0) != I2COK)
+	{
+		t1 = HAL_I2C_TICKS();
+		wait += (uint16_t)(t1 - t0);
+		t0 = t1;
+		if(wait > I2C_EEPROM_TIMEOUT_TICKS)
+			break;
+	}
+	eep->bus->polling = 0;
+	return wait > I2C_EEPROM_TIMEOUT_TICKS ? I2CERROR : I2COK;
+}
+
+
+/**
+ * 发送字地址和count个字节的数据，失败时重试直到超时（ACK轮询）
+ */
+static I2CResult _I2CEepromSend(I2CEeprom * eep, uint32_t addr, const uint8_t * I2Cdata, uint16_t count)
+{
+	uint8_t head[2];
+	uint8_t address = eep->address;
+	uint16_t t0, t1;
+	uint32_t wait = 0;
+
+	if(eep->addrBytes == 2)
+	{
+		head[0] = (uint8_t)(addr >> 8);
+		head[1] = (uint8_t)addr;
+	}
+	else
+	{
+		/* 8位字地址时高位为设备地址的块地址 */
+		head[0] = (uint8_t)addr;
+		address |= (uint8_t)(addr >> 8) & 0x07;
+	}
+
+	/* 写周期内的地址无应答计入总线的stats.polls，不计入nacks */
+	eep->bus->polling = 1;
+	t0 = HAL_I2C_TICKS();
+	while(I2CBusWriteBlock(eep->bus, address, eep->addrBytes, head, count, I2Cdata) != I2COK)
+	{
+		t1 = HAL_I2C_TICKS();
+		wait += (uint16_t)(t1 - t0);
+		t0 = t1;
+		if(wait > I2C_EEPROM_TIMEOUT_TICKS)
+			break;
+	}
+	eep->bus->polling = 0;
+	return wait > I2C_EEPROM_TIMEOUT_TICKS ? I2CERROR : I2COK;
+}
@@ -0,0 +1,121 @@
+/**
+ * \file
+ *
+ * \brief 24Cxx系列I2C EEPROM读写程序
+ *
+ * \author 高明飞
+ *
+ * \date 2026-10-18
+ *
+ * \details
+ * 写入时按页边界拆分，每页在一次传输中连续发送字地址和整页数据（I2CBusWriteBlock），
+ * 不再逐字节写入并在每个字节后固定等待写周期。\n
+ * 写周期内EEPROM不应答自己的地址，下一页的写入失败时立即重试（ACK轮询），
+ * 写周期一结束就开始写入下一页，不需要按最长写周期时间等待。
+ * 例如页大小为32字节时，写入2KiB约为逐字节写入的1/30时间。\n
+ * 支持8位字地址（24C01~24C16，容量大于256字节时高位在设备地址的低3位中）和16位字地址（24C32及以上）。
+ *
+ * 使用方法：
+ *   static I2CEeprom Eep;
+ *   I2CEepromInit(&Eep, &I2CDefaultBus, 0x50, 32768, 64, 2);    24C256
+ *   I2CEepromWrite(&Eep, 0x0100, Calib, sizeof(Calib));
+ *   I2CEepromRead(&Eep, 0x0100, Calib, sizeof(Calib));
+ *
+ * \note
+ * -I2CEepromWrite返回时最后一页的写周期可能尚未结束，
+ *  之后的I2CEepromRead会自动等待，掉电或操作同一总线上的其他设备前可调用I2CEepromWait;\n
+ * -ACK轮询期间置位总线的polling，地址无应答计入stats.polls，不计入nacks，也不记录传输段;\n
+ * -等待超时使用GPIO_I2C.h中的HAL_I2C_TICKS计数器.
+ *
+ * 修改记录：\n
+ *
+ * 2026-10-18 :\n
+ *   -File Created.\n
+ *
+ */
+
+#ifndef I2C_EEPROM_H
+#define I2C_EEPROM_H
+
+/* I2CBus及计数器的定义 */
+#include "GPIO_I2C.h"
+
+/*--------------------此部分需要修改--------------------*/
+
+/**
+ * 等待写周期结束（ACK轮询）的最长时间(ms)，一般为最长写周期时间tWR的2倍，超时后返回I2CERROR
+ */
+#define I2C_EEPROM_TIMEOUT 20
+
+/*--------------------此部分需要修改--------------------*/
+
+/** EEPROM对象 */
+typedef struct
+{
+	I2CBus * bus;        /**< 所在的总线 */
+	uint8_t address;     /**< 7位地址，8位字地址时为块0的地址 */
+	uint8_t addrBytes;   /**< 字地址字节数，1或2 */
+	uint16_t page;       /**< 页大小（字节） */
+	uint32_t size;       /**< 容量（字节） */
+} I2CEeprom;
+
+
+/**
+ * 初始化EEPROM对象
+ *
+ * \param eep       : EEPROM对象指针
+ * \param bus       : 所在的总线，如&I2CDefaultBus
+ * \param address   : 7位地址，如0x50
+ * \param size      : 容量（字节），如24C02为256，24C256为32768
+ * \param page      : 页大小（字节），如24C02为8，24C256为64
+ * \param addrBytes : 字地址字节数，24C01~24C16为1，24C32及以上为2
+ *
+ */
+void I2CEepromInit(I2CEeprom * eep, I2CBus * bus, uint8_t address, uint32_t size, uint16_t page, uint8_t addrBytes);
+
+
+/**
+ * 写入数据，按页边界拆分，每页一次传输，写周期内ACK轮询
+ *
+ * \param eep     : EEPROM对象指针
+ * \param addr    : 起始地址
+ * \param I2Cdata : 写入的数据
+ * \param count   : 数据长度
+ *
+ * \return 执行结果
+ * \retval I2COK    : 成功
+ * \retval I2CERROR : 超出容量，或等待超时，此时之前的页已写入
+ *
+ */
+I2CResult I2CEepromWrite(I2CEeprom * eep, uint32_t addr, const uint8_t I2Cdata[], uint16_t count);
+
+
+/**
+ * 读取数据，正在写周期时先等待
+ *
+ * \param eep     : EEPROM对象指针
+ * \param addr    : 起始地址
+ * \param I2Cdata : 读取结果存放数组
+ * \param count   : 数据长度
+ *
+ * \return 执行结果
+ * \retval I2COK    : 成功
+ * \retval I2CERROR : 超出容量，或等待超时
+ *
+ */
+I2CResult I2CEepromRead(I2CEeprom * eep, uint32_t addr, uint8_t I2Cdata[], uint16_t count);
+
+
+/**
+ * 等待写周期结束
+ *
+ * \param eep : EEPROM对象指针
+ *
+ * \return 执行结果
+ * \retval I2COK    : 成功
+ * \retval I2CERROR : 等待超时
+ *
+ */
+I2CResult I2CEepromWait(I2CEeprom * eep);
+
+#endif
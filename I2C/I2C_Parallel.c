@@ -0,0 +1,278 @@
+/**
+ * \file
+ *
+ * \brief 同一GPIO端口上多路并行的GPIO模拟I2C程序
+ *
+ * \author 高明飞
+ *
+ * \date 2026-10-18
+ *
+ * \details
+ * 发送时先将各路的一个字节转置为8个端口值（第k个端口值为各路数据的第7-k位），
+ * 接收时先按位保存8次端口采样值，字节结束后再转置为各路的数据，
+ * 转置在字节之间进行，每个SCL时钟内只有一次端口写入或读取。
+ *
+ * 修改记录：\n
+ *
+ * 2026-10-18 :\n
+ *   -File Created.\n
+ *
+ */
+
+#include "I2C_Parallel.h"
+
+/* 四分之一SCL周期的计数值 */
+#define I2CP_QUARTER ((uint16_t)((HAL_I2C_TICK_HZ + I2CP_SPEED_HZ * 4 - 1) / (I2CP_SPEED_HZ * 4)))
+
+/* 时钟延展超时的计数值 */
+#define I2CP_STRETCH_TICKS (HAL_I2C_TICK_HZ / 1000UL * I2C_STRETCH_TIMEOUT / 1000UL)
+
+/* 上一次延时的结束时刻 */
+static uint16_t _I2CPNext;
+/* 本次传输中从设备时钟延展超时 */
+static uint8_t _I2CPTimeout;
+
+/* 内部使用的函数声明 */
+static void _I2CPDelay(void);
+static void _I2CPSclHigh(void);
+static I2CPMask _I2CPClock(I2CPMask sda);
+static void _I2CPStart(I2CPMask lines);
+static void _I2CPStop(I2CPMask lines);
+static I2CPMask _I2CPSendByte(uint8_t databyte, I2CPMask active);
+static I2CPMask _I2CPSendBytes(const uint8_t * I2Cdata, uint8_t stride, I2CPMask active);
+static void _I2CPGetBytes(uint8_t * I2Cdata, uint8_t stride, I2CPMask active, uint8_t last);
+
+/**
+ * 向多路总线上的从设备写寄存器，各路写入不同的数据
+ *
+ * \param buses   : 参与传输的总线掩码
+ * \param address : 从设备地址，各路相同
+ * \param reg     : 起始寄存器地址，各路相同
+ * \param count   : 每路写入的字节数
+ * \param I2Cdata : 写入的数据，第b路为 I2Cdata[b * count] ~ I2Cdata[b * count + count - 1]
+ *
+ * \return 所有字节都收到应答的总线掩码
+ *
+ */
+I2CPMask I2CPWriteRegs(I2CPMask buses, uint8_t address, uint8_t reg, uint8_t count, const uint8_t I2Cdata[])
+{
+	I2CPMask active = buses & I2CP_SDA_MASK;
+	uint8_t j;
+
+	_I2CPTimeout = 0;
+	_I2CPStart(active);
+	active = _I2CPSendByte(address << 1, active);
+	active = _I2CPSendByte(reg, active);
+	for(j = 0; j < count && active != 0; j++)
+	{
+		active = _I2CPSendBytes(I2Cdata + j, count, active);
+	}
+	_I2CPStop(buses & I2CP_SDA_MASK);
+
+	return _I2CPTimeout ? 0 : active;
+}
+
+
+/**
+ * 从多路总线上的从设备读取寄存器
+ *
+ * \param buses   : 参与传输的总线掩码
+ * \param address : 从设备地址，各路相同
+ * \param reg     : 起始寄存器地址，各路相同
+ * \param count   : 每路读取的字节数，不能为0
+ * \param I2Cdata : 读取结果存放数组，第b路为 I2Cdata[b * count] ~ I2Cdata[b * count + count - 1]
+ *
+ * \return 读取成功的总线掩码，未成功的总线对应的数据不确定
+ *
+ */
+I2CPMask I2CPReadRegs(I2CPMask buses, uint8_t address, uint8_t reg, uint8_t count, uint8_t I2Cdata[])
+{
+	I2CPMask active = buses & I2CP_SDA_MASK;
+	uint8_t j;
+
+	if(count == 0)
+		return 0;
+
+	_I2CPTimeout = 0;
+	_I2CPStart(active);
+	active = _I2CPSendByte(address << 1, active);
+	active = _I2CPSendByte(reg, active);
+	if(active != 0)
+	{
+		_I2CPStart(active);
+		active = _I2CPSendByte((address << 1) | 0x01, active);
+	}
+	/* 最后一个字节发送NOACK */
+	for(j = 0; j < count && active != 0; j++)
+	{
+		_I2CPGetBytes(I2Cdata + j, count, active, j + 1 == count);
+	}
+	_I2CPStop(buses & I2CP_SDA_MASK);
+
+	return _I2CPTimeout ? 0 : active;
+}
+
+
+/**
+ * 延时函数，延时的时间为SCL周期的1/4，从上一次延时结束起计时
+ */
+static void _I2CPDelay(void)
+{
+	uint16_t next = _I2CPNext + I2CP_QUARTER;
+
+	while((int16_t)(HAL_I2C_TICKS() - next) < 0);
+	_I2CPNext = next;
+}
+
+/**
+ * 释放SCL并等待其变为高电平，从设备时钟延展超时后置位_I2CPTimeout
+ */
+static void _I2CPSclHigh(void)
+{
+	uint16_t t0, t1;
+	uint32_t wait = 0;
+
+	HAL_I2CP_SCL_W(1);
+	t0 = HAL_I2C_TICKS();
+	while(HAL_I2CP_SCL_R == 0 && !_I2CPTimeout)
+	{
+		t1 = HAL_I2C_TICKS();
+		wait += (uint16_t)(t1 - t0);
+		t0 = t1;
+		if(wait > I2CP_STRETCH_TICKS)
+			_I2CPTimeout = 1;
+	}
+	_I2CPNext = HAL_I2C_TICKS();
+}
+
+/**
+ * 输出一个SCL时钟，低电平期间所有SDA输出sda，高电平结束前返回所有SDA的采样值
+ */
+static I2CPMask _I2CPClock(I2CPMask sda)
+{
+	/* 低电平时间从SCL变低开始计算，之前的数据处理时间计入高电平 */
+	HAL_I2CP_SCL_W(0);
+	_I2CPNext = HAL_I2C_TICKS();
+	_I2CPDelay();
+	HAL_I2CP_SDA_W(sda);
+	_I2CPDelay();
+	_I2CPSclHigh();
+	_I2CPDelay();
+	_I2CPDelay();
+	return HAL_I2CP_SDA_R() & I2CP_SDA_MASK;
+}
+
+/**
+ * 在lines中的总线上发送Start信号，也用于重复Start
+ */
+static void _I2CPStart(I2CPMask lines)
+{
+	HAL_I2CP_SCL_W(0);
+	_I2CPNext = HAL_I2C_TICKS();
+	_I2CPDelay();
+	HAL_I2CP_SDA_W(I2CP_SDA_MASK);
+	_I2CPDelay();
+	_I2CPSclHigh();
+	_I2CPDelay();
+	_I2CPDelay();
+	HAL_I2CP_SDA_W((I2CPMask)~lines);
+	_I2CPDelay();
+	_I2CPDelay();
+}
+
+/**
+ * 在lines中的总线上发送Stop信号
+ */
+static void _I2CPStop(I2CPMask lines)
+{
+	HAL_I2CP_SCL_W(0);
+	_I2CPNext = HAL_I2C_TICKS();
+	_I2CPDelay();
+	HAL_I2CP_SDA_W((I2CPMask)~lines);
+	_I2CPDelay();
+	_I2CPSclHigh();
+	_I2CPDelay();
+	_I2CPDelay();
+	HAL_I2CP_SDA_W(I2CP_SDA_MASK);
+	_I2CPDelay();
+	_I2CPDelay();
+}
+
+/**
+ * 向active中的总线发送同一个字节，返回收到ACK的总线掩码
+ */
+static I2CPMask _I2CPSendByte(uint8_t databyte, I2CPMask active)
+{
+	uint8_t k;
+
+	if(active == 0)
+		return 0;
+
+	/* 未参与的总线释放SDA */
+	for(k = 0x80; k != 0; k >>= 1)
+	{
+		_I2CPClock(databyte & k ? I2CP_SDA_MASK : (I2CPMask)~active);
+	}
+	return active & ~_I2CPClock(I2CP_SDA_MASK);
+}
+
+/**
+ * 向active中的总线各发送一个字节，第b路为I2Cdata[b * stride]，返回收到ACK的总线掩码
+ */
+static I2CPMask _I2CPSendBytes(const uint8_t * I2Cdata, uint8_t stride, I2CPMask active)
+{
+	I2CPMask port[8];
+	uint8_t k, b, databyte;
+
+	/* 转置：port[k]的第b位为第b路数据的第7-k位 */
+	for(k = 0; k < 8; k++)
+		port[k] = (I2CPMask)~active;
+	for(b = 0; b < I2CP_BUS_NUM; b++)
+	{
+		if(active & (1 << b))
+		{
+			databyte = I2Cdata[b * stride];
+			for(k = 0; k < 8; k++)
+			{
+				if(databyte & (0x80 >> k))
+					port[k] |= 1 << b;
+			}
+		}
+	}
+
+	for(k = 0; k < 8; k++)
+	{
+		_I2CPClock(port[k]);
+	}
+	return active & ~_I2CPClock(I2CP_SDA_MASK);
+}
+
+/**
+ * 从active中的总线各读取一个字节存入I2Cdata[b * stride]，last不为0时发送NOACK
+ */
+static void _I2CPGetBytes(uint8_t * I2Cdata, uint8_t stride, I2CPMask active, uint8_t last)
+{
+	I2CPMask port[8];
+	uint8_t k, b, databyte;
+
+	for(k = 0; k < 8; k++)
+	{
+		port[k] = _I2CPClock(I2CP_SDA_MASK);
+	}
+	/* 各路总线分别发送ACK */
+	_I2CPClock(last ? I2CP_SDA_MASK : (I2CPMask)~active);
+
+	/* 转置：第b路数据的第7-k位为port[k]的第b位 */
+	for(b = 0; b < I2CP_BUS_NUM; b++)
+	{
+		if(active & (1 << b))
+		{
+			databyte = 0;
+			for(k = 0; k < 8; k++)
+			{
+				databyte = (databyte << 1) | ((port[k] >> b) & 0x01);
+			}
+			I2Cdata[b * stride] = databyte;
+		}
+	}
+}
@@ -0,0 +1,123 @@
+/**
+ * \file
+ *
+ * \brief 同一GPIO端口上多路并行的GPIO模拟I2C程序
+ *
+ * \author 高明飞
+ *
+ * \date 2026-10-18
+ *
+ * \details
+ * 多个相同地址的从设备（如传感器阵列）分别接在同一端口的不同SDA引脚上，共用SCL。
+ * 每个SCL时钟只需一次端口写入即可输出所有总线的数据位，一次端口读取即可采样所有总线的
+ * ACK位和数据位，N个从设备的读写时间与一个从设备相同。\n
+ * 端口的第b位为第b路总线的SDA，多路数据按总线顺序存放：第b路总线的第j个字节为 I2Cdata[b * count + j]。\n
+ * 每路总线独立判断ACK，无应答的总线之后释放SDA，不影响其他总线，
+ * 函数返回所有字节都收到应答的总线掩码。
+ *
+ * 使用方法：
+ *   uint8_t acc[I2CP_BUS_NUM * 6];
+ *   I2CPMask ok = I2CPReadRegs(0xFF, 0x68, 0x3B, 6, acc);
+ *   第b路的数据为acc[b * 6] ~ acc[b * 6 + 5]，(ok >> b) & 1为第b路是否成功
+ *
+ * \note
+ * -延时使用GPIO_I2C.h中的HAL_I2C_TICKS计数器;\n
+ * -SCL也可以是同一端口上的多个引脚，HAL_I2CP_SCL_W同时写所有SCL，
+ *  HAL_I2CP_SCL_R在所有SCL均为高电平时为1.
+ *
+ * 修改记录：\n
+ *
+ * 2026-10-18 :\n
+ *   -File Created.\n
+ *   -示例HAL_I2CP_SDA_W保持端口上其他引脚的状态，增加I2C_HOST时的HAL宏定义\n
+ *
+ */
+
+#ifndef I2C_PARALLEL_H
+#define I2C_PARALLEL_H
+
+/* 计数器及I2C_STRETCH_TIMEOUT的定义 */
+#include "GPIO_I2C.h"
+
+/*--------------------此部分需要修改--------------------*/
+
+/**
+ * 总线个数，2~8，第b路总线的SDA为端口的第b位
+ */
+#define I2CP_BUS_NUM 8
+
+#ifdef I2C_HOST
+/* Linux主机仿真环境，各路总线为I2CHostParallelInit指定的仿真总线 */
+#define HAL_I2CP_SDA_W(BITS)  I2CHostParallelSdaWrite((uint8_t)(BITS))
+#define HAL_I2CP_SDA_R()      (I2CHostParallelSdaRead())
+#define HAL_I2CP_SCL_W(STATE) I2CHostParallelSclWrite((uint8_t)(STATE))
+#define HAL_I2CP_SCL_R        (I2CHostParallelSclRead())
+#else
+/**
+ * 同时写所有SDA，BITS的第b位为第b路总线的SDA电平，此处以STC15的P1口为例。
+ * 端口上不属于SDA的位需保持原有状态：先用ORL释放要变高的SDA，再用ANL拉低要变低的SDA，
+ * 两条指令都是对端口锁存器的读-改-写，每个引脚最多变化一次
+ */
+#define HAL_I2CP_SDA_W(BITS) (P1 |= (uint8_t)((BITS) & I2CP_SDA_MASK), \
+                              P1 &= (uint8_t)((BITS) | ~I2CP_SDA_MASK))
+
+/**
+ * 同时读取所有SDA的电平
+ */
+#define HAL_I2CP_SDA_R() (P1)
+
+/**
+ * 时钟信号(SCL)宏定义，指定SCL电平
+ */
+#define HAL_I2CP_SCL_W(STATE) (P35 = STATE)
+
+/**
+ * 读取时钟信号(SCL)当前电位，需为开漏输出（或准双向口）
+ */
+#define HAL_I2CP_SCL_R (P35)
+#endif
+
+/**
+ * SCL频率(Hz)
+ */
+#define I2CP_SPEED_HZ 100000UL
+
+/*--------------------此部分需要修改--------------------*/
+
+/** 总线掩码，第b位对应第b路总线 */
+typedef uint8_t I2CPMask;
+
+/** 所有总线的SDA掩码 */
+#define I2CP_SDA_MASK ((I2CPMask)((1U << I2CP_BUS_NUM) - 1))
+
+
+/**
+ * 向多路总线上的从设备写寄存器，各路写入不同的数据
+ *
+ * \param buses   : 参与传输的总线掩码
+ * \param address : 从设备地址，各路相同
+ * \param reg     : 起始寄存器地址，各路相同
+ * \param count   : 每路写入的字节数
+ * \param I2Cdata : 写入的数据，第b路为 I2Cdata[b * count] ~ I2Cdata[b * count + count - 1]
+ *
+ * \return 所有字节都收到应答的总线掩码
+ *
+ */
+I2CPMask I2CPWriteRegs(I2CPMask buses, uint8_t address, uint8_t reg, uint8_t count, const uint8_t I2Cdata[]);
+
+
+/**
+ * 从多路总线上的从设备读取寄存器
+ *
+ * \param buses   : 参与传输的总线掩码
+ * \param address : 从设备地址，各路相同
+ * \param reg     : 起始寄存器地址，各路相同
+ * \param count   : 每路读取的字节数，不能为0
+ * \param I2Cdata : 读取结果存放数组，第b路为 I2Cdata[b * count] ~ I2Cdata[b * count + count - 1]
+ *
+ * \return 读取成功的总线掩码，未成功的总线对应的数据不确定
+ *
+ */
+I2CPMask I2CPReadRegs(I2CPMask buses, uint8_t address, uint8_t reg, uint8_t count, uint8_t I2Cdata[]);
+
+#endif
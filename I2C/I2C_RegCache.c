@@ -0,0 +1,301 @@
+/**
+ * \file
+ *
+ * \brief I2C从设备寄存器影子缓存
+ *
+ * \author 高明飞
+ *
+ * \date 2026-10-18
+ *
+ * \details
+ * 缓存空间依次为count字节的影子值、有效位图和脏位图，位图的第i位对应寄存器base+i。\n
+ * 脏寄存器一定有效；易失寄存器从不有效，也从不为脏。
+ *
+ * 修改记录：\n
+ *
+ * 2026-10-18 :\n
+ *   -File Created.\n
+ *
+ */
+
+#include "I2C_RegCache.h"
+
+/* 位图操作，i为相对base的序号 */
+#define I2C_RC_TEST(MAP, i) ((MAP)[(i) >> 3] & (uint8_t)(1 << ((i) & 7)))
+#define I2C_RC_SET(MAP, i)  ((MAP)[(i) >> 3] |= (uint8_t)(1 << ((i) & 7)))
+#define I2C_RC_CLR(MAP, i)  ((MAP)[(i) >> 3] &= (uint8_t)~(1 << ((i) & 7)))
+
+/* 序号i是否为易失寄存器 */
+#define I2C_RC_VOLATILE(cache, i) ((cache)->vmap != 0 && I2C_RC_TEST((cache)->vmap, i))
+
+/* 寄存器是否在缓存范围内，范围内时序号存入i */
+#define I2C_RC_INDEX(cache, reg, i) ((i) = (uint8_t)((reg) - (cache)->base), (i) < (cache)->count)
+
+/* 内部使用的函数声明 */
+static void _I2CRegCacheClear(I2CRegCache * cache);
+static I2CResult _I2CRegCacheSend(I2CRegCache * cache, uint8_t first, uint8_t last);
+
+/**
+ * 初始化寄存器缓存，所有寄存器为无效，写通模式
+ *
+ * \param cache   : 缓存对象指针
+ * \param bus     : 所在的总线，如&I2CDefaultBus
+ * \param address : 7位地址
+ * \param base    : 缓存的第一个寄存器地址
+ * \param count   : 缓存的寄存器个数，base + count不超过256
+ * \param vmap    : 易失寄存器位图，I2C_REGCACHE_BITS(count)字节，为0时全部为非易失寄存器
+ * \param mem     : 缓存空间，I2C_REGCACHE_MEM(count)字节
+ *
+ */
+void I2CRegCacheInit(I2CRegCache * cache, I2CBus * bus, uint8_t address, uint8_t base, uint8_t count,
+                     const uint8_t * vmap, uint8_t * mem)
+{
+	cache->bus = bus;
+	cache->address = address;
+	cache->base = base;
+	cache->count = count;
+	cache->writeBack = 0;
+	cache->vmap = vmap;
+	cache->shadow = mem;
+	cache->valid = mem + count;
+	cache->dirty = cache->valid + I2C_REGCACHE_BITS(count);
+	cache->hits = 0;
+	cache->elided = 0;
+	_I2CRegCacheClear(cache);
+}
+
+
+/**
+ * 读取寄存器，非易失寄存器已缓存时不访问总线
+ *
+ * \param cache   : 缓存对象指针
+ * \param reg     : 寄存器地址
+ * \param I2Cdata : 读取结果存放地址
+ *
+ * \return 执行结果
+ * \retval I2COK    : 成功
+ * \retval I2CERROR : 失败
+ *
+ */
+I2CResult I2CRegCacheRead(I2CRegCache * cache, uint8_t reg, uint8_t * I2Cdata)
+{
+	uint8_t i;
+
+	if(!I2C_RC_INDEX(cache, reg, i) || I2C_RC_VOLATILE(cache, i))
+		return I2CBusReadReg(cache->bus, cache->address, reg, I2Cdata);
+
+	if(I2C_RC_TEST(cache->valid, i))
+	{
+		cache->hits++;
+		*I2Cdata = cache->shadow[i];
+		return I2COK;
+	}
+	if(I2CBusReadReg(cache->bus, cache->address, reg, &cache->shadow[i]) != I2COK)
+		return I2CERROR;
+	I2C_RC_SET(cache->valid, i);
+	*I2Cdata = cache->shadow[i];
+	return I2COK;
+}
+
+
+/**
+ * 写入寄存器，非易失寄存器的值与缓存相同时不访问总线；回写模式下只修改缓存
+ *
+ * \param cache   : 缓存对象指针
+ * \param reg     : 寄存器地址
+ * \param I2Cdata : 写入的值
+ *
+ * \return 执行结果
+ * \retval I2COK    : 成功
+ * \retval I2CERROR : 失败，缓存的值为无效
+ *
+ */
+I2CResult I2CRegCacheWrite(I2CRegCache * cache, uint8_t reg, uint8_t I2Cdata)
+{
+	uint8_t i;
+
+	if(!I2C_RC_INDEX(cache, reg, i) || I2C_RC_VOLATILE(cache, i))
+		return I2CBusWriteReg(cache->bus, cache->address, reg, I2Cdata);
+
+	if(I2C_RC_TEST(cache->valid, i) && cache->shadow[i] == I2Cdata)
+	{
+		cache->elided++;
+		return I2COK;
+	}
+	cache->shadow[i] = I2Cdata;
+	I2C_RC_SET(cache->valid, i);
+	if(cache->writeBack)
+	{
+		I2C_RC_SET(cache->dirty, i);
+		return I2COK;
+	}
+	if(I2CBusWriteReg(cache->bus, cache->address, reg, I2Cdata) != I2COK)
+	{
+		/* 设备中的值未知 */
+		I2C_RC_CLR(cache->valid, i);
+		return I2CERROR;
+	}
+	return I2COK;
+}
+
+
+/**
+ * 读-改-写寄存器的部分位：新值 = (原值 & ~mask) | (I2Cdata & mask)
+ *
+ * \param cache   : 缓存对象指针
+ * \param reg     : 寄存器地址
+ * \param mask    : 要修改的位
+ * \param I2Cdata : 要修改的位的新值
+ *
+ * \return 执行结果
+ * \retval I2COK    : 成功
+ * \retval I2CERROR : 失败
+ *
+ */
+I2CResult I2CRegCacheUpdate(I2CRegCache * cache, uint8_t reg, uint8_t mask, uint8_t I2Cdata)
+{
+	uint8_t value;
+
+	if(I2CRegCacheRead(cache, reg, &value) != I2COK)
+		return I2CERROR;
+	return I2CRegCacheWrite(cache, reg, (value & ~mask) | (I2Cdata & mask));
+}
+
+
+/**
+ * 发送回写模式下修改的寄存器，相邻的脏寄存器合并为一次连续写入
+ *
+ * \param cache : 缓存对象指针
+ *
+ * \return 执行结果
+ * \retval I2COK    : 成功
+ * \retval I2CERROR : 失败，未发送成功的寄存器仍为脏
+ *
+ */
+I2CResult I2CRegCacheFlush(I2CRegCache * cache)
+{
+	uint8_t i, first, last, gap;
+	I2CResult res = I2COK;
+
+	i = 0;
+	while(i < cache->count)
+	{
+		if(!I2C_RC_TEST(cache->dirty, i))
+		{
+			i++;
+			continue;
+		}
+
+		/* 向后延伸，跨过不超过I2C_REGCACHE_GAP个有效的非易失寄存器 */
+		first = i;
+		last = i;
+		gap = 0;
+		for(i++; i < cache->count; i++)
+		{
+			if(I2C_RC_TEST(cache->dirty, i))
+			{
+				last = i;
+				gap = 0;
+			}
+			else if(gap < I2C_REGCACHE_GAP && I2C_RC_TEST(cache->valid, i))
+				gap++;
+			else
+				break;
+		}
+
+		if(_I2CRegCacheSend(cache, first, last) != I2COK)
+			res = I2CERROR;
+		i = last + 1;
+	}
+	return res;
+}
+
+
+/**
+ * 从设备读取缓存范围内的所有非易失寄存器，相邻的非易失寄存器合并为一次连续读取，
+ * 易失寄存器不读取；之前先发送未发送的修改
+ *
+ * \param cache : 缓存对象指针
+ *
+ * \return 执行结果
+ * \retval I2COK    : 成功
+ * \retval I2CERROR : 失败，读取失败的寄存器为无效，其他寄存器不受影响
+ *
+ */
+I2CResult I2CRegCacheLoad(I2CRegCache * cache)
+{
+	uint8_t i, first;
+	I2CResult res = I2COK;
+
+	if(I2CRegCacheFlush(cache) != I2COK)
+		return I2CERROR;
+
+	i = 0;
+	while(i < cache->count)
+	{
+		if(I2C_RC_VOLATILE(cache, i))
+		{
+			i++;
+			continue;
+		}
+
+		/* 向后延伸到下一个易失寄存器之前 */
+		first = i;
+		for(i++; i < cache->count && !I2C_RC_VOLATILE(cache, i); i++);
+
+		if(I2CBusReadRegs(cache->bus, cache->address, cache->base + first, i - first, &cache->shadow[first]) != I2COK)
+		{
+			/* 影子值可能已被部分改写 */
+			for(; first < i; first++)
+				I2C_RC_CLR(cache->valid, first);
+			res = I2CERROR;
+			continue;
+		}
+		for(; first < i; first++)
+			I2C_RC_SET(cache->valid, first);
+	}
+	return res;
+}
+
+
+/**
+ * 使所有缓存的值无效，未发送的修改被丢弃，用于从设备复位或掉电后
+ *
+ * \param cache : 缓存对象指针
+ *
+ */
+void I2CRegCacheInvalidate(I2CRegCache * cache)
+{
+	_I2CRegCacheClear(cache);
+}
+
+
+/**
+ * 清除有效位图和脏位图
+ */
+static void _I2CRegCacheClear(I2CRegCache * cache)
+{
+	uint8_t i;
+
+	for(i = 0; i < I2C_REGCACHE_BITS(cache->count); i++)
+	{
+		cache->valid[i] = 0;
+		cache->dirty[i] = 0;
+	}
+}
+
+
+/**
+ * 连续写入序号first~last的寄存器，成功后清除脏标记
+ */
+static I2CResult _I2CRegCacheSend(I2CRegCache * cache, uint8_t first, uint8_t last)
+{
+	uint8_t reg = cache->base + first;
+	uint8_t i;
+
+	if(I2CBusWriteBlock(cache->bus, cache->address, 1, &reg, last - first + 1, &cache->shadow[first]) != I2COK)
+		return I2CERROR;
+	for(i = first; i <= last; i++)
+		I2C_RC_CLR(cache->dirty, i);
+	return I2COK;
+}
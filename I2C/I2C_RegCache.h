@@ -0,0 +1,174 @@
+/**
+ * \file
+ *
+ * \brief I2C从设备寄存器影子缓存
+ *
+ * \author 高明飞
+ *
+ * \date 2026-10-18
+ *
+ * \details
+ * 在RAM中保存从设备一段连续寄存器的副本（影子），减少驱动程序读-改-写产生的总线传输：\n
+ *   -写入的值与缓存相同时不发送;\n
+ *   -读取非易失寄存器时直接返回缓存的值;\n
+ *   -回写模式下写入只修改缓存并标记为脏，I2CRegCacheFlush时将相邻的脏寄存器合并为一次连续写入.\n
+ * 易失寄存器（状态、数据、命令等会被设备自己修改或写入有副作用的寄存器）在寄存器表中标记，
+ * 每次都直接读写设备。缓存范围之外的寄存器也直接读写设备。
+ *
+ * 使用方法：
+ *   寄存器0x00~0x3F，其中0x00~0x0F为易失寄存器
+ *   static const uint8_t SensorVolatile[I2C_REGCACHE_BITS(64)] = { 0xFF, 0xFF };
+ *   static uint8_t SensorMem[I2C_REGCACHE_MEM(64)];
+ *   static I2CRegCache Sensor;
+ *   I2CRegCacheInit(&Sensor, &I2CDefaultBus, 0x68, 0x00, 64, SensorVolatile, SensorMem);
+ *   I2CRegCacheUpdate(&Sensor, 0x1A, 0x07, 0x03);   修改0x1A的低3位，值不变时没有总线传输
+ *
+ * \note
+ * -合并写入要求从设备连续写入时寄存器地址自动递增;\n
+ * -从设备复位或掉电后需要调用I2CRegCacheInvalidate;\n
+ * -不在中断中使用，同一设备的缓存不能被多处同时修改.
+ *
+ * 修改记录：\n
+ *
+ * 2026-10-18 :\n
+ *   -File Created.\n
+ *
+ */
+
+#ifndef I2C_REGCACHE_H
+#define I2C_REGCACHE_H
+
+/* I2CBus的定义 */
+#include "GPIO_I2C.h"
+
+/*--------------------此部分需要修改--------------------*/
+
+/**
+ * 合并写入时可以跨过的相同（非脏）寄存器个数。
+ * 重新写入少量不变的非易失寄存器比另起一次传输（Start、地址、寄存器地址）更快，为0时只合并相邻的脏寄存器
+ */
+#define I2C_REGCACHE_GAP 2
+
+/*--------------------此部分需要修改--------------------*/
+
+/** count个寄存器的位图字节数 */
+#define I2C_REGCACHE_BITS(count) (((count) + 7) / 8)
+
+/** count个寄存器需要的缓存空间：影子值、有效位图和脏位图 */
+#define I2C_REGCACHE_MEM(count) ((count) + 2 * I2C_REGCACHE_BITS(count))
+
+/** 寄存器缓存对象 */
+typedef struct
+{
+	I2CBus * bus;               /**< 所在的总线 */
+	uint8_t address;            /**< 7位地址 */
+	uint8_t base;               /**< 缓存的第一个寄存器地址 */
+	uint8_t count;              /**< 缓存的寄存器个数 */
+	uint8_t writeBack;          /**< 0：写入立即发送（写通），1：写入在I2CRegCacheFlush时发送（回写） */
+	const uint8_t * vmap;       /**< 易失寄存器位图，第i位为1表示base+i为易失寄存器，为0时全部为非易失寄存器 */
+	uint8_t * shadow;           /**< 影子值 */
+	uint8_t * valid;            /**< 有效位图 */
+	uint8_t * dirty;            /**< 脏位图 */
+	uint16_t hits;              /**< 从缓存读取的次数 */
+	uint16_t elided;            /**< 因值不变而省略的写入次数 */
+} I2CRegCache;
+
+
+/**
+ * 初始化寄存器缓存，所有寄存器为无效，写通模式
+ *
+ * \param cache   : 缓存对象指针
+ * \param bus     : 所在的总线，如&I2CDefaultBus
+ * \param address : 7位地址
+ * \param base    : 缓存的第一个寄存器地址
+ * \param count   : 缓存的寄存器个数，base + count不超过256
+ * \param vmap    : 易失寄存器位图，I2C_REGCACHE_BITS(count)字节，为0时全部为非易失寄存器
+ * \param mem     : 缓存空间，I2C_REGCACHE_MEM(count)字节
+ *
+ */
+void I2CRegCacheInit(I2CRegCache * cache, I2CBus * bus, uint8_t address, uint8_t base, uint8_t count,
+                     const uint8_t * vmap, uint8_t * mem);
+
+
+/**
+ * 读取寄存器，非易失寄存器已缓存时不访问总线
+ *
+ * \param cache   : 缓存对象指针
+ * \param reg     : 寄存器地址
+ * \param I2Cdata : 读取结果存放地址
+ *
+ * \return 执行结果
+ * \retval I2COK    : 成功
+ * \retval I2CERROR : 失败
+ *
+ */
+I2CResult I2CRegCacheRead(I2CRegCache * cache, uint8_t reg, uint8_t * I2Cdata);
+
+
+/**
+ * 写入寄存器，非易失寄存器的值与缓存相同时不访问总线；回写模式下只修改缓存
+ *
+ * \param cache   : 缓存对象指针
+ * \param reg     : 寄存器地址
+ * \param I2Cdata : 写入的值
+ *
+ * \return 执行结果
+ * \retval I2COK    : 成功
+ * \retval I2CERROR : 失败，缓存的值为无效
+ *
+ */
+I2CResult I2CRegCacheWrite(I2CRegCache * cache, uint8_t reg, uint8_t I2Cdata);
+
+
+/**
+ * 读-改-写寄存器的部分位：新值 = (原值 & ~mask) | (I2Cdata & mask)
+ *
+ * \param cache   : 缓存对象指针
+ * \param reg     : 寄存器地址
+ * \param mask    : 要修改的位
+ * \param I2Cdata : 要修改的位的新值
+ *
+ * \return 执行结果
+ * \retval I2COK    : 成功
+ * \retval I2CERROR : 失败
+ *
+ */
+I2CResult I2CRegCacheUpdate(I2CRegCache * cache, uint8_t reg, uint8_t mask, uint8_t I2Cdata);
+
+
+/**
+ * 发送回写模式下修改的寄存器，相邻的脏寄存器合并为一次连续写入
+ *
+ * \param cache : 缓存对象指针
+ *
+ * \return 执行结果
+ * \retval I2COK    : 成功
+ * \retval I2CERROR : 失败，未发送成功的寄存器仍为脏
+ *
+ */
+I2CResult I2CRegCacheFlush(I2CRegCache * cache);
+
+
+/**
+ * 从设备读取缓存范围内的所有非易失寄存器，相邻的非易失寄存器合并为一次连续读取，
+ * 易失寄存器不读取；之前先发送未发送的修改
+ *
+ * \param cache : 缓存对象指针
+ *
+ * \return 执行结果
+ * \retval I2COK    : 成功
+ * \retval I2CERROR : 失败，读取失败的寄存器为无效，其他寄存器不受影响
+ *
+ */
+I2CResult I2CRegCacheLoad(I2CRegCache * cache);
+
+
+/**
+ * 使所有缓存的值无效，未发送的修改被丢弃，用于从设备复位或掉电后
+ *
+ * \param cache : 缓存对象指针
+ *
+ */
+void I2CRegCacheInvalidate(I2CRegCache * cache);
+
+#endif
@@ -0,0 +1,207 @@
+/**
+  **************************************************************
+  * @file       SerialBench.c
+  * @author	    高明飞
+  * @version    V0.1
+  * @date       2026-10-18
+  *
+  * @brief      Serial_BSP在Linux主机上的吞吐量测试
+  *
+  * @details
+  * @verbatim
+  * 对每个UARTPortSend*函数连续调用一段时间，输出MB/s及每MB的系统调用次数。
+  *
+  * 编译：
+  *   gcc -O2 -DSERIAL_HOST -ISerial -ISerial/Host -ITypeDef \
+  *       Serial/Serial_BSP.c Serial/Host/Serial_Host.c Serial/Host/SerialBench.c \
+  *       -o SerialBench
+  * 加上-DUART_STATS后，另外输出每次调用的平均/最大耗时及等待耗时（rdtsc计数），
+  * 最后在模拟阻塞发送的串口上连续调用到总耗时超过2^32个计数，检查耗时累计值饱和。
+  * 运行：
+  *   ./SerialBench [输出文件，默认为/dev/null]
+  *
+  * 修改记录：
+  * 2026-10-18 :
+  *   - File Created.
+  * @endverbatim
+  ***************************************************************
+  */
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "Serial_BSP.h"
+
+/* 每个函数的测试时间，秒 */
+#define BENCH_SECONDS 0.5
+
+/* 测试数据 */
+static uint8_t ByteData[8192];
+static uint16_t WordData[128];
+static uint32_t DwordData[64];
+
+static UARTPort Port;
+static SerialHost Host;
+
+/* 测试项，执行一次调用 */
+static void BenchChar(void)          { UARTPortSendChar(&Port, 'A'); }
+static void BenchByte(void)          { UARTPortSendByte(&Port, 0x5A); }
+static void BenchWord(void)          { UARTPortSendWord(&Port, 0x1234); }
+static void BenchDword(void)         { UARTPortSendDword(&Port, 0x12345678); }
+static void BenchUnsignDec(void)     { UARTPortSendUnsignASCII(&Port, 4000000000u, 10, 0); }
+static void BenchUnsignHex(void)     { UARTPortSendUnsignASCII(&Port, 0xDEADBEEF, 16, 8); }
+static void BenchUnsignBin(void)     { UARTPortSendUnsignASCII(&Port, 0xA5A5, 2, 16); }
+static void BenchSign(void)          { UARTPortSendSignASCII(&Port, -123456, 0); }
+static void BenchFixed(void)         { UARTPortSendFixed(&Port, -1234567, 15, 4); }
+static void BenchFloat(void)         { UARTPortSendFloat(&Port, 3.14159265f, 6); }
+static void BenchString(void)        { UARTPortSendString(&Port, "The quick brown fox jumps over the lazy dog\r\n"); }
+static void BenchByteArray16(void)   { UARTPortSendByteArray(&Port, ByteData, 16); }
+static void BenchByteArray256(void)  { UARTPortSendByteArray(&Port, ByteData, 256); }
+static void BenchWordArray(void)     { UARTPortSendWordArray(&Port, WordData, 128); }
+static void BenchByteArray8K(void)   { UARTPortSendByteArray(&Port, ByteData, 8192); }
+static void BenchDwordArray(void)    { UARTPortSendDwordArray(&Port, DwordData, 64); }
+static void BenchPrintf(void)        { UARTPortPrintf(&Port, "adc=%u temp=%d reg=%x\r\n", 1234u, -5, 0x1Fu); }
+
+typedef struct
+{
+  const char * name;
+  void (*func)(void);
+} BenchItem;
+
+static const BenchItem Items[] =
+{
+  { "UARTPortSendChar",              BenchChar },
+  { "UARTPortSendByte",              BenchByte },
+  { "UARTPortSendWord",              BenchWord },
+  { "UARTPortSendDword",             BenchDword },
+  { "UARTPortSendUnsignASCII(10)",   BenchUnsignDec },
+  { "UARTPortSendUnsignASCII(16)",   BenchUnsignHex },
+  { "UARTPortSendUnsignASCII(2)",    BenchUnsignBin },
+  { "UARTPortSendSignASCII",         BenchSign },
+  { "UARTPortSendFixed(Q15, 4)",     BenchFixed },
+  { "UARTPortSendFloat(6)",          BenchFloat },
+  { "UARTPortSendString",            BenchString },
+  { "UARTPortSendByteArray(16)",     BenchByteArray16 },
+  { "UARTPortSendByteArray(256)",    BenchByteArray256 },
+  { "UARTPortSendByteArray(8192)",   BenchByteArray8K },
+  { "UARTPortSendWordArray(128)",    BenchWordArray },
+  { "UARTPortSendDwordArray(64)",    BenchDwordArray },
+  { "UARTPortPrintf",                BenchPrintf },
+};
+
+static double Now(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+#ifdef UART_STATS
+/* 模拟阻塞发送的串口：每SPIN_POLLS次查询才有一次发送寄存器可写 */
+#define SPIN_POLLS 64
+
+static uint32_t SpinCount;
+
+static void SpinSend(void * hw, uint8_t UARTdata) { (void)hw; (void)UARTdata; }
+static uint8_t SpinReady(void * hw) { (void)hw; return ++SpinCount % SPIN_POLLS == 0; }
+
+static const UARTPortOps SpinOps = { SpinSend, SpinReady, 0, 0 };
+static UARTPort SpinPort;
+
+/* 阻塞串口上连续调用到实际总耗时为2^32的1.5倍（等待约占其中的3/4），检查耗时累计值饱和而不是回绕 */
+static void BenchSaturate(void)
+{
+  const UARTFuncStats * st = &SpinPort.stats.func[UART_STATS_BYTE_ARRAY];
+  uint64_t total = 0, t0;
+
+  UARTPortInit(&SpinPort, &SpinOps, 0, 0, 0);
+  while(total < 0x180000000ULL)
+  {
+    t0 = __rdtsc();
+    UARTPortSendByteArray(&SpinPort, ByteData, 256);
+    total += __rdtsc() - t0;
+  }
+
+  printf("saturation: %.2fG cycles in %lu calls, cycles=0x%08lX wait=0x%08lX port wait=0x%08lX: %s\n",
+         total / 1e9, (unsigned long)st->calls, (unsigned long)st->cycles,
+         (unsigned long)st->waitCycles, (unsigned long)SpinPort.stats.waitCycles,
+         st->cycles == UART_STATS_MAX && st->waitCycles == UART_STATS_MAX
+         && SpinPort.stats.waitCycles == UART_STATS_MAX ? "saturated" : "ERROR: not saturated");
+}
+#endif
+
+int main(int argc, char * argv[])
+{
+  const char * path = argc > 1 ? argv[1] : "/dev/null";
+  unsigned i, k;
+  int fd;
+
+  fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if(fd < 0)
+  {
+    perror(path);
+    return 1;
+  }
+
+  for(i = 0; i < sizeof(ByteData); i++)
+    ByteData[i] = (uint8_t)i;
+  for(i = 0; i < sizeof(WordData) / sizeof(WordData[0]); i++)
+    WordData[i] = (uint16_t)(i * 0x0101);
+  for(i = 0; i < sizeof(DwordData) / sizeof(DwordData[0]); i++)
+    DwordData[i] = i * 0x01010101u;
+
+  SerialHostInit(&Host, fd);
+  SerialHostPortInit(&Port, &Host);
+
+  printf("%-30s %10s %14s", "function", "MB/s", "syscalls/MB");
+#ifdef UART_STATS
+  printf(" %10s %10s %10s", "avg", "max", "wait");
+#endif
+  printf("\n");
+  for(k = 0; k < sizeof(Items) / sizeof(Items[0]); k++)
+  {
+    double start, elapsed;
+    double bytes = 0;
+    uint32_t sys0 = Host.syscalls;
+    double mb;
+
+    /* txBytes为32位，每1000次调用累加一次，防止溢出 */
+    UARTPortStatsReset(&Port);
+    start = Now();
+    do
+    {
+      Port.stats.txBytes = 0;
+      for(i = 0; i < 1000; i++)
+        Items[k].func();
+      bytes += Port.stats.txBytes;
+      elapsed = Now() - start;
+    } while(elapsed < BENCH_SECONDS);
+    SerialHostFlush(&Host);
+    elapsed = Now() - start;
+
+    mb = bytes / 1e6;
+    printf("%-30s %10.1f %14.1f", Items[k].name, mb / elapsed,
+           (Host.syscalls - sys0) / mb);
+#ifdef UART_STATS
+    /* 每项只调用一个函数，取有调用记录的一项 */
+    for(i = 0; i < UART_STATS_FUNC_NUM; i++)
+    {
+      const UARTFuncStats * st = &Port.stats.func[i];
+
+      if(st->calls != 0)
+        printf(" %10.1f %10lu %10.1f", (double)st->cycles / st->calls,
+               (unsigned long)st->maxCycles, (double)st->waitCycles / st->calls);
+    }
+#endif
+    printf("\n");
+  }
+
+#ifdef UART_STATS
+  BenchSaturate();
+#endif
+
+  close(fd);
+  return 0;
+}
@@ -0,0 +1,216 @@
+/**
+  **************************************************************
+  * @file       Serial_Host.c
+  * @author	    高明飞
+  * @version    V0.1
+  * @date       2026-10-18
+  *
+  * @brief      Serial_BSP的Linux主机底层实现
+  *
+  * @details
+  * @verbatim
+  * 发送的数据先存入暂存缓存，缓存满或调用SerialHostFlush时用一次writev写出。
+  *
+  * 修改记录：
+  * 2026-10-18 :
+  *   - File Created.
+  * @endverbatim
+  ***************************************************************
+  */
+
+/** @addtogroup Serial
+  * @{
+  */
+
+/** @addtogroup SerialHost
+  * @{
+  */
+
+#include <errno.h>
+#include <string.h>
+#include <sys/uio.h>
+
+#include "Serial_BSP.h"
+
+/* 内部使用的函数声明 */
+static ErrorStatus _SerialHostWritev(SerialHost * host, struct iovec * iov, int iovcnt);
+static void _SerialHostSend(void * hw, uint8_t UARTdata);
+static uint8_t _SerialHostTxReady(void * hw);
+static void _SerialHostSendBlock(void * hw, const uint8_t * UARTdata, uint16_t num);
+
+/* UARTPort底层操作 */
+static const UARTPortOps _SerialHostOps =
+{
+  _SerialHostSend, _SerialHostTxReady, 0, _SerialHostSendBlock
+};
+
+/** 默认串口使用的输出对象，输出到标准输出 */
+SerialHost SerialHostDefault = { 1, {0}, 0, 0, 0 };
+
+/**
+  * @brief  初始化主机输出对象
+  *
+  * @param  host: 主机输出对象指针
+  * @param  fd:   输出文件描述符
+  *
+  * @retval None
+  */
+void SerialHostInit(SerialHost * host, int fd)
+{
+  host->fd = fd;
+  host->used = 0;
+  host->syscalls = 0;
+  host->errors = 0;
+}
+
+/**
+  * @brief  初始化输出到主机文件描述符的串口对象
+  *
+  * @param  port: 串口对象指针
+  * @param  host: 已初始化的主机输出对象
+  *
+  * @retval SUCCESS 执行成功
+  * @retval ERROR   执行错误
+  */
+ErrorStatus SerialHostPortInit(struct UARTPort_t * port, SerialHost * host)
+{
+  return UARTPortInit(port, &_SerialHostOps, host, 0, 0);
+}
+
+/**
+  * @brief  发送一个字节，存入暂存缓存
+  *
+  * @param  host: 主机输出对象指针
+  * @param  c:    需要发送的字节
+  *
+  * @retval None
+  */
+void SerialHostPutByte(SerialHost * host, uint8_t c)
+{
+  if(host->used >= SERIAL_HOST_BUFFER_SIZE)
+    SerialHostFlush(host);
+  host->Buffer[host->used++] = c;
+}
+
+/**
+  * @brief  发送一段数据
+  *
+  * @param  host: 主机输出对象指针
+  * @param  data: 数据头指针
+  * @param  num:  数据长度
+  *
+  * @retval None
+  *
+  * @note
+  * 暂存缓存放得下时复制到暂存缓存；放不下时与暂存缓存中的数据一起用一次writev写出，不复制。
+  */
+void SerialHostWrite(SerialHost * host, const uint8_t * data, uint16_t num)
+{
+  struct iovec iov[2];
+
+  if(host->used + num > SERIAL_HOST_BUFFER_SIZE)
+  {
+    iov[0].iov_base = host->Buffer;
+    iov[0].iov_len = host->used;
+    iov[1].iov_base = (void *)data;
+    iov[1].iov_len = num;
+    _SerialHostWritev(host, iov, 2);
+    host->used = 0;
+    return;
+  }
+
+  memcpy(host->Buffer + host->used, data, num);
+  host->used += num;
+}
+
+/**
+  * @brief  写出暂存缓存中的全部数据
+  *
+  * @param  host: 主机输出对象指针
+  *
+  * @retval SUCCESS 执行成功
+  * @retval ERROR   写入失败，数据已丢弃
+  */
+ErrorStatus SerialHostFlush(SerialHost * host)
+{
+  struct iovec iov;
+  ErrorStatus res;
+
+  if(host->used == 0)
+    return SUCCESS;
+
+  iov.iov_base = host->Buffer;
+  iov.iov_len = host->used;
+  res = _SerialHostWritev(host, &iov, 1);
+  host->used = 0;
+
+  return res;
+}
+
+/**
+  * @brief  写出全部iovec，处理部分写入和EINTR
+  */
+static ErrorStatus _SerialHostWritev(SerialHost * host, struct iovec * iov, int iovcnt)
+{
+  ssize_t n;
+
+  while(iovcnt > 0)
+  {
+    if(iov->iov_len == 0)
+    {
+      iov++;
+      iovcnt--;
+      continue;
+    }
+
+    host->syscalls++;
+    n = writev(host->fd, iov, iovcnt);
+    if(n < 0)
+    {
+      if(errno == EINTR || errno == EAGAIN)
+        continue;
+      host->errors++;
+      return ERROR;
+    }
+
+    /* 跳过已写出的部分 */
+    while(iovcnt > 0 && (size_t)n >= iov->iov_len)
+    {
+      n -= iov->iov_len;
+      iov++;
+      iovcnt--;
+    }
+    if(iovcnt > 0)
+    {
+      iov->iov_base = (uint8_t *)iov->iov_base + n;
+      iov->iov_len -= n;
+    }
+  }
+
+  return SUCCESS;
+}
+
+/* UARTPort底层操作 */
+static void _SerialHostSend(void * hw, uint8_t UARTdata)
+{
+  SerialHostPutByte((SerialHost *)hw, UARTdata);
+}
+
+static uint8_t _SerialHostTxReady(void * hw)
+{
+  (void)hw;
+  return 1;
+}
+
+static void _SerialHostSendBlock(void * hw, const uint8_t * UARTdata, uint16_t num)
+{
+  SerialHostWrite((SerialHost *)hw, UARTdata, num);
+}
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
@@ -0,0 +1,108 @@
+/**
+  **************************************************************
+  * @file       Serial_Host.h
+  * @author	    高明飞
+  * @version    V0.1
+  * @date       2026-10-18
+  *
+  * @brief      Serial_BSP的Linux主机底层实现
+  *
+  * @details
+  * @verbatim
+  * 用于在Linux上运行Serial_BSP，输出到pty、文件、管道或socket等任意文件描述符，
+  * 便于仿真和吞吐量测试。
+  *
+  * 发送的数据先存入暂存缓存，缓存满或调用SerialHostFlush时用一次writev写出；
+  * 暂存缓存放不下的数据段不复制，与暂存缓存中的数据作为两个iovec一起写出。
+  * 不会逐字节调用write。程序结束前需调用SerialHostFlush写出剩余数据。
+  *
+  * 编译时定义SERIAL_HOST，并将本目录加入头文件搜索路径，例如：
+  *   gcc -DSERIAL_HOST -ISerial -ISerial/Host -ITypeDef \
+  *       Serial/Serial_BSP.c Serial/Host/Serial_Host.c main.c
+  *
+  * 默认串口UARTDefaultPort输出到SerialHostDefault（标准输出）。
+  *
+  * 修改记录：
+  * 2026-10-18 :
+  *   - File Created.
+  * @endverbatim
+  ***************************************************************
+  */
+
+#ifndef SERIAL_HOST_H
+#define SERIAL_HOST_H
+
+/* C++ */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* 使用系统的stdint.h，TypeDef.h中只取Bool和ErrorStatus */
+#include <stdint.h>
+#define TYPE_UINT32_T
+#define TYPE_UINT16_T
+#define TYPE_UINT8_T
+#define TYPE_INT32_T
+#define TYPE_INT16_T
+#define TYPE_INT8_T
+#include "TypeDef.h"
+
+/** @addtogroup Serial
+  * @{
+  */
+
+/** @addtogroup SerialHost
+  * @brief      Serial_BSP的Linux主机底层实现
+  * @{
+  */
+
+/**
+  * 暂存缓存大小
+  */
+#define SERIAL_HOST_BUFFER_SIZE 4096
+
+/**
+  * @brief  主机输出对象
+  */
+typedef struct
+{
+  int fd;                                   /*!<输出文件描述符 */
+  uint8_t Buffer[SERIAL_HOST_BUFFER_SIZE];  /*!<暂存缓存 */
+  uint16_t used;                            /*!<暂存缓存中的字节数 */
+  uint32_t syscalls;                        /*!<writev调用次数 */
+  uint32_t errors;                          /*!<写入失败次数 */
+} SerialHost;
+
+/** 默认串口使用的输出对象，输出到标准输出 */
+extern SerialHost SerialHostDefault;
+
+/* 默认串口的HAL宏定义 */
+#define HAL_UART_SEND_UINT8(UARTdata) SerialHostPutByte(&SerialHostDefault, (uint8_t)(UARTdata))
+#define HAL_UART_TX_READY (1)
+
+struct UARTPort_t;
+
+void SerialHostInit(SerialHost * host, int fd);
+
+ErrorStatus SerialHostPortInit(struct UARTPort_t * port, SerialHost * host);
+
+void SerialHostPutByte(SerialHost * host, uint8_t c);
+
+void SerialHostWrite(SerialHost * host, const uint8_t * data, uint16_t num);
+
+ErrorStatus SerialHostFlush(SerialHost * host);
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/* C++ */
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,255 @@
+/**
+  **************************************************************
+  * @file       SerialFrame.c
+  * @author	    高明飞
+  * @version    V0.1
+  * @date       2026-10-18
+  *
+  * @brief      COBS + CRC-32 二进制数据帧
+  *
+  * @details
+  * @verbatim
+  * 帧格式：COBS( 数据 + CRC-32(数据, 高字节在前) ) + 0x00
+  *
+  * 修改记录：
+  * 2026-10-18 :
+  *   - File Created.
+  *   - SerialFrameSend增加串口对象参数
+  *   - SerialFrameSend直接编码到串口发送缓存，去掉模块内部的发送缓存
+  *   - CRC_Calculate改为可重入，编码和解码可分别在主循环和中断中调用
+  * @endverbatim
+  ***************************************************************
+  */
+
+/** @addtogroup Serial
+  * @{
+  */
+
+/** @addtogroup SerialFrame
+  * @{
+  */
+
+#include "SerialFrame.h"
+
+/* COBS编码状态，位置为out中的下标，按mask回绕，可直接写入环形发送缓存 */
+typedef struct
+{
+  uint8_t * out;    /* 输出缓存 */
+  uint16_t mask;    /* 下标掩码，线性缓存为0xFFFF */
+  uint16_t n;       /* 下一个输出字节的位置 */
+  uint16_t codeIdx; /* 当前数据块编码字节的位置 */
+  uint8_t code;     /* 当前数据块编码字节的值 */
+} _FrameEncoder;
+
+/* 内部使用的函数声明 */
+static uint16_t _FrameEncode(uint8_t * out, uint16_t mask, uint16_t pos,
+                             const uint8_t * data, uint16_t num);
+static void _FrameEncodeByte(_FrameEncoder * enc, uint8_t c);
+
+/**
+  * @brief  将数据编码为一帧
+  *
+  * @param  data: 数据头指针
+  * @param  num:  数据长度
+  * @param  out:  编码结果存放位置，大小至少为SERIAL_FRAME_ENCODED_SIZE(num)
+  *
+  * @retval 编码后的长度，包括结束符
+  *
+  * @note
+  * 数据直接编码到out中，不需要额外的缓存；out可以是发送缓存或DMA缓存。
+  */
+uint16_t SerialFrameEncode(const uint8_t * data, uint16_t num, uint8_t * out)
+{
+  return _FrameEncode(out, 0xFFFF, 0, data, num);
+}
+
+/**
+  * @brief  编码并发送一帧
+  *
+  * @param  port: 串口对象指针，必须有发送缓存
+  * @param  data: 数据头指针
+  * @param  num:  数据长度，不大于SERIAL_FRAME_MAX_PAYLOAD
+  *
+  * @retval SUCCESS 已写入发送缓存
+  * @retval ERROR   数据过长、串口无发送缓存或发送缓存小于SERIAL_FRAME_ENCODED_SIZE(num)，未发送
+  *
+  * @note
+  * 用UARTPortTxReserve预留空间后直接编码到发送缓存中，不经过中间缓存，
+  * 缓存空闲不足时等待。无发送缓存的串口可用SerialFrameEncode编码到自己的缓存后发送。
+  */
+ErrorStatus SerialFrameSend(UARTPort * port, const uint8_t * data, uint16_t num)
+{
+  uint16_t size, pos;
+
+  if(num > SERIAL_FRAME_MAX_PAYLOAD || port->txBuffer == 0)
+    return ERROR;
+
+  size = SERIAL_FRAME_ENCODED_SIZE(num);
+  if((uint16_t)(size - 1) > port->txMask)
+    return ERROR;
+
+  pos = UARTPortTxReserve(port, size);
+  UARTPortTxCommit(port, _FrameEncode(port->txBuffer, port->txMask, pos, data, num));
+
+  return SUCCESS;
+}
+
+/**
+  * @brief  初始化流式解码器
+  *
+  * @param  dec: 解码器指针
+  *
+  * @retval None
+  */
+void SerialFrameDecoderInit(SerialFrameDecoder * dec)
+{
+  dec->length = 0;
+  dec->remain = 0;
+  dec->code = 0;
+  dec->error = 0;
+}
+
+/**
+  * @brief  向解码器输入一个接收到的字节
+  *
+  * @param  dec: 解码器指针
+  * @param  c:   接收到的字节
+  *
+  * @retval FRAME_NONE  帧未结束
+  * @retval FRAME_OK    收到一个完整帧，数据在dec->Buffer中，长度为dec->length，
+  *                     在下一次调用本函数之前有效
+  * @retval FRAME_ERROR 收到一个错误帧，已丢弃
+  *
+  * @note
+  * 可在接收中断中逐字节调用。出错后丢弃数据直到下一个结束符，
+  * 因此线路干扰最多影响当前一帧。
+  */
+SerialFrameStatus SerialFrameDecode(SerialFrameDecoder * dec, uint8_t c)
+{
+  uint16_t len;
+  uint8_t error;
+  uint32_t crc;
+
+  if(c == SERIAL_FRAME_DELIMITER)
+  {
+    /* 连续的结束符，忽略 */
+    if(dec->code == 0 && dec->error == 0)
+      return FRAME_NONE;
+
+    /* 最后一个数据块不完整也视为错误 */
+    len = dec->length;
+    error = dec->error || dec->remain != 0;
+    SerialFrameDecoderInit(dec);
+
+    if(error || len < SERIAL_FRAME_CRC_SIZE)
+      return FRAME_ERROR;
+
+    len -= SERIAL_FRAME_CRC_SIZE;
+    crc = ((uint32_t)dec->Buffer[len] << 24) | ((uint32_t)dec->Buffer[len + 1] << 16)
+        | ((uint32_t)dec->Buffer[len + 2] << 8) | (uint32_t)dec->Buffer[len + 3];
+    if(CRC_Calculate(dec->Buffer, len) != crc)
+      return FRAME_ERROR;
+
+    dec->length = len;
+    return FRAME_OK;
+  }
+
+  if(dec->error)
+    return FRAME_NONE;
+
+  if(dec->remain == 0)
+  {
+    /* 帧开始，丢弃上一帧的数据 */
+    if(dec->code == 0)
+      dec->length = 0;
+    /* 编码字节，上一个数据块不满254字节时，其后隐含一个0 */
+    else if(dec->code != 0xFF)
+    {
+      if(dec->length >= sizeof(dec->Buffer))
+      {
+        dec->error = 1;
+        return FRAME_NONE;
+      }
+      dec->Buffer[dec->length++] = 0;
+    }
+    dec->code = c;
+    dec->remain = c - 1;
+  }
+  else
+  {
+    if(dec->length >= sizeof(dec->Buffer))
+    {
+      dec->error = 1;
+      return FRAME_NONE;
+    }
+    dec->Buffer[dec->length++] = c;
+    dec->remain--;
+  }
+
+  return FRAME_NONE;
+}
+
+/**
+  * @brief  将数据编码为一帧，写入out[(pos + i) & mask]
+  *
+  * @retval 编码后的长度，包括结束符
+  */
+static uint16_t _FrameEncode(uint8_t * out, uint16_t mask, uint16_t pos,
+                             const uint8_t * data, uint16_t num)
+{
+  _FrameEncoder enc;
+  uint32_t crc;
+  uint16_t i;
+
+  crc = CRC_Calculate(data, num);
+
+  enc.out = out;
+  enc.mask = mask;
+  enc.codeIdx = pos;
+  enc.n = pos + 1;
+  enc.code = 1;
+
+  for(i = 0; i < num; i++)
+    _FrameEncodeByte(&enc, data[i]);
+
+  _FrameEncodeByte(&enc, (uint8_t)(crc >> 24 & 0xFF));
+  _FrameEncodeByte(&enc, (uint8_t)(crc >> 16 & 0xFF));
+  _FrameEncodeByte(&enc, (uint8_t)(crc >> 8 & 0xFF));
+  _FrameEncodeByte(&enc, (uint8_t)(crc & 0xFF));
+
+  /* 结束最后一个数据块 */
+  out[enc.codeIdx & mask] = enc.code;
+  out[enc.n++ & mask] = SERIAL_FRAME_DELIMITER;
+
+  return (uint16_t)(enc.n - pos);
+}
+
+/**
+  * @brief  COBS编码一个字节
+  */
+static void _FrameEncodeByte(_FrameEncoder * enc, uint8_t c)
+{
+  if(c == 0)
+  {
+    enc->out[enc->codeIdx & enc->mask] = enc->code;
+    enc->codeIdx = enc->n++;
+    enc->code = 1;
+    return;
+  }
+
+  enc->out[enc->n++ & enc->mask] = c;
+  if(++enc->code == 0xFF)
+  {
+    enc->out[enc->codeIdx & enc->mask] = enc->code;
+    enc->codeIdx = enc->n++;
+    enc->code = 1;
+  }
+}
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
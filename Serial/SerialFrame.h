@@ -0,0 +1,114 @@
+/**
+  **************************************************************
+  * @file       SerialFrame.h
+  * @author	    高明飞
+  * @version    V0.1
+  * @date       2026-10-18
+  *
+  * @brief      COBS + CRC-32 二进制数据帧
+  *
+  * @details
+  * @verbatim
+  * 直接使用UARTSendByteArray等函数发送二进制数据时，接收方丢失一个字节后无法重新同步。
+  * 本模块将数据封装为帧：
+  *   COBS( 数据 + CRC-32(数据, 高字节在前) ) + 0x00
+  * COBS编码后帧内不含0x00，0x00只作为帧结束符，
+  * 接收方遇到0x00即可丢弃当前错误数据，从下一帧开始恢复正常。
+  *
+  * 编码开销固定：每254字节增加1字节，另加CRC 4字节和结束符1字节。
+  *
+  * 修改记录：
+  * 2026-10-18 :
+  *   - File Created.
+  *   - SerialFrameSend增加串口对象参数
+  *   - SerialFrameSend直接编码到串口发送缓存，去掉模块内部的发送缓存
+  *   - CRC_Calculate改为可重入，编码和解码可分别在主循环和中断中调用
+  * @endverbatim
+  *
+  * @note
+  * CRC使用CRC模块中的CRC_Calculate，该函数可重入，因此在接收中断中解码的同时
+  * 主循环可以编码其他帧。同一个解码器或同一个串口不能同时在两处使用。
+  ***************************************************************
+  */
+
+#ifndef SERIALFRAME_H
+#define SERIALFRAME_H
+
+/* C++ */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "Serial_BSP.h"
+#include "CRC.h"
+
+/** @addtogroup Serial
+  * @{
+  */
+
+/** @addtogroup SerialFrame
+  * @brief      COBS + CRC-32 二进制数据帧
+  * @{
+  */
+
+/*--------------------此部分需要修改--------------------*/
+/**
+  * 每帧最大数据长度（不含CRC），决定接收缓存的大小及SerialFrameSend可发送的最大长度
+  */
+#define SERIAL_FRAME_MAX_PAYLOAD 250
+/*--------------------此部分需要修改--------------------*/
+
+/** 帧结束符 */
+#define SERIAL_FRAME_DELIMITER 0x00
+
+/** CRC字节数 */
+#define SERIAL_FRAME_CRC_SIZE 4
+
+/**
+  * 数据长度为n时编码后的最大长度，包括COBS开销、CRC和结束符
+  */
+#define SERIAL_FRAME_ENCODED_SIZE(n) \
+  ((n) + SERIAL_FRAME_CRC_SIZE + ((n) + SERIAL_FRAME_CRC_SIZE) / 254 + 2)
+
+/** 接收状态 */
+typedef enum
+{
+  FRAME_NONE,   /**< 帧未结束 */
+  FRAME_OK,     /**< 收到一个完整帧，CRC正确 */
+  FRAME_ERROR   /**< 收到一个错误帧（COBS格式错误、长度溢出或CRC错误），已丢弃 */
+} SerialFrameStatus;
+
+/**
+  * @brief  流式解码器
+  */
+typedef struct
+{
+  uint8_t Buffer[SERIAL_FRAME_MAX_PAYLOAD + SERIAL_FRAME_CRC_SIZE]; /*!<解码后的数据 */
+  uint16_t length;                          /*!<数据长度，FRAME_OK时不含CRC */
+  uint8_t remain;                           /*!<当前COBS数据块剩余字节数 */
+  uint8_t code;                             /*!<当前COBS数据块的编码字节，0表示帧开始 */
+  uint8_t error;                            /*!<当前帧已出错，等待结束符 */
+} SerialFrameDecoder;
+
+uint16_t SerialFrameEncode(const uint8_t * data, uint16_t num, uint8_t * out);
+
+ErrorStatus SerialFrameSend(UARTPort * port, const uint8_t * data, uint16_t num);
+
+void SerialFrameDecoderInit(SerialFrameDecoder * dec);
+
+SerialFrameStatus SerialFrameDecode(SerialFrameDecoder * dec, uint8_t c);
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/* C++ */
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -24,6 +24,18 @@
   *   - 进一步修改注释格式。
   * 2015-11-26 :
   *   - 去掉内联函数inline（因为很多编译器对此的支持均有问题）
+  * 2026-10-18 :
+  *   - UARTSendUnsignASCII中2、8、10、16进制改为不使用除法的转换方法
+  *   - 添加UART_ASCII_GENERIC宏定义
+  *   - 添加UARTPort串口对象，支持多个串口同时使用，每个串口有独立的发送缓存和统计信息
+  *   - 原有函数改为使用默认串口UARTDefaultPort
+  *   - printf中%c改为按int取参数
+  *   - UARTPortOps增加SendBlock，UARTPortSendByteArray可整段发送
+  *   - 字/双字数组先转换字节序到暂存区再整段发送，有发送缓存时整段写入发送缓存
+  *   - 添加UART_STATS统计，等待发送统一由_UARTWait处理
+  *   - 添加UARTSendFixed、UARTSendFloat，printf支持%f、%.Nf
+  *   - UART_STATS的耗时累计值改为饱和累加，不再回绕
+  *   - 添加UARTPortTxReserve、UARTPortTxCommit，可直接写入发送缓存
   * @endverbatim
   *
   * @note
@@ -38,78 +50,304 @@
 
 #include "Serial_BSP.h"
 
+#include "string.h"
+
 #ifndef UART_LEGACY
 #include "stdarg.h"
 #endif
 
+/* GCC/Clang小端平台上用字节交换指令（x86 bswap、ARM REV）转换字节序 */
+#if defined(__GNUC__) && defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define UART_SWAP_BUILTIN
+#endif
+
+#ifndef UART_ASCII_GENERIC
+/* 数字字符表，2、8、16进制转换时按位查表 */
+static const char _UARTDigitTable[] = "0123456789ABCDEF";
+
+/* 两位十进制数字表，"00"~"99"，每个数占两个字符 */
+static const char _UARTDec2Table[] =
+  "00010203040506070809"
+  "10111213141516171819"
+  "20212223242526272829"
+  "30313233343536373839"
+  "40414243444546474849"
+  "50515253545556575859"
+  "60616263646566676869"
+  "70717273747576777879"
+  "80818283848586878889"
+  "90919293949596979899";
+
+/* 十进制高6位的权值，低4位由两位数字表处理 */
+static const uint32_t _UARTDecPow10[6] =
+{
+  1000000000, 100000000, 10000000, 1000000, 100000, 10000
+};
+
+/* 内部使用的函数声明 */
+static signed char _UARTPow2ToStr(uint32_t UARTdata, uint8_t shift, char * str);
+static signed char _UARTDecToStr(uint32_t UARTdata, char * str);
+static signed char _UARTBaseToStr(uint32_t UARTdata, uint8_t base, char * str);
+#endif
+
+#ifdef UART_STATS
+/* 发送函数开始时的计数值 */
+typedef struct
+{
+  uint32_t start;
+  uint32_t bytes;
+  uint8_t outer;
+} UARTStatsMark;
+
+/* 放在发送函数的变量声明之后、函数返回之前 */
+#define UART_STATS_BEGIN(port) UARTStatsMark _mark; _UARTStatsBegin((port), &_mark)
+#define UART_STATS_END(port, func) _UARTStatsEnd((port), &_mark, (func))
+
+static void _UARTStatsBegin(UARTPort * port, UARTStatsMark * mark);
+static void _UARTStatsEnd(UARTPort * port, const UARTStatsMark * mark, UARTStatsFunc func);
+#else
+#define UART_STATS_BEGIN(port) ((void)0)
+#define UART_STATS_END(port, func) ((void)0)
+#endif
+
+/* 内部使用的函数声明 */
+static void _UARTPut(UARTPort * port, uint8_t c);
+static void _UARTSendFrac(UARTPort * port, uint8_t neg, uint32_t ip, uint32_t f, uint8_t frac, uint8_t prec);
+static void _UARTWait(UARTPort * port, uint16_t head);
+static void _UARTPutBlock(UARTPort * port, const uint8_t * data, uint16_t num);
+static void _UARTSwapWord(uint8_t * out, const uint16_t * in, uint16_t num);
+static void _UARTSwapDword(uint8_t * out, const uint32_t * in, uint16_t num);
+#ifndef UART_LEGACY
+static void _UARTVprintf(UARTPort * port, const char *format, va_list ap);
+#endif
+
+#ifndef UART_NO_DEFAULT_PORT
+/* 默认串口的底层操作，使用HAL宏定义 */
+static void _UARTHalSend(void * hw, uint8_t UARTdata)
+{
+  (void)hw;
+  HAL_UART_SEND_UINT8(UARTdata);
+}
+
+static uint8_t _UARTHalTxReady(void * hw)
+{
+  (void)hw;
+  return HAL_UART_TX_READY ? 1 : 0;
+}
+
+static const UARTPortOps _UARTHalOps = { _UARTHalSend, _UARTHalTxReady, 0, 0 };
+
+/** 默认串口，使用HAL宏定义，不使用发送缓存 */
+UARTPort UARTDefaultPort = { &_UARTHalOps, 0, 0, 0, 0, 0, { 0 } };
+#endif
+
+/**
+  * @brief  初始化串口对象
+  *
+  * @param  port:     串口对象指针
+  * @param  ops:      底层操作
+  * @param  hw:       底层操作使用的参数，一般为寄存器组地址
+  * @param  txBuffer: 发送缓存，为空时不使用发送缓存
+  * @param  txSize:   发送缓存大小，必须为2的整数次幂，且不大于32768
+  *
+  * @retval SUCCESS 执行成功
+  * @retval ERROR   参数错误
+  *
+  * @note
+  * 使用发送缓存时ops->TxIntEnable不能为空，且需要在发送中断中调用UARTPortTxISR。
+  */
+ErrorStatus UARTPortInit(UARTPort * port, const UARTPortOps * ops, void * hw,
+                         uint8_t * txBuffer, uint16_t txSize)
+{
+  if(txBuffer != 0 && (ops->TxIntEnable == 0 || txSize < 2 || txSize > 32768
+                       || (txSize & (txSize - 1)) != 0))
+    return ERROR;
+
+  port->ops = ops;
+  port->hw = hw;
+  port->txBuffer = txBuffer;
+  port->txMask = txBuffer != 0 ? txSize - 1 : 0;
+  port->txHead = 0;
+  port->txTail = 0;
+  UARTPortStatsReset(port);
+
+  return SUCCESS;
+}
+
+/**
+  * @brief  清零统计信息
+  *
+  * @param  port: 串口对象指针
+  *
+  * @retval None
+  */
+void UARTPortStatsReset(UARTPort * port)
+{
+  port->stats.txBytes = 0;
+  port->stats.txWait = 0;
+#ifdef UART_STATS
+  port->stats.waitCycles = 0;
+  port->stats.callWait = 0;
+  port->stats.depth = 0;
+  memset(port->stats.func, 0, sizeof(port->stats.func));
+#endif
+}
+
+/**
+  * @brief  发送中断中调用，将发送缓存中的数据写入发送寄存器
+  *
+  * @param  port: 串口对象指针
+  *
+  * @retval None
+  *
+  * @note   发送缓存为空时关闭发送中断；带FIFO的串口一次可写入多个字节
+  */
+void UARTPortTxISR(UARTPort * port)
+{
+  uint16_t tail = port->txTail;
+
+  while(tail != port->txHead && port->ops->TxReady(port->hw))
+  {
+    port->ops->SendUint8(port->hw, port->txBuffer[tail & port->txMask]);
+    tail++;
+  }
+  port->txTail = tail;
+
+  if(tail == port->txHead)
+    port->ops->TxIntEnable(port->hw, 0);
+}
+
+/**
+  * @brief  等待发送缓存中的数据全部写入发送寄存器
+  *
+  * @param  port: 串口对象指针
+  *
+  * @retval None
+  */
+void UARTPortFlush(UARTPort * port)
+{
+  if(port->txBuffer != 0)
+    while(port->txTail != port->txHead);
+}
+
+/**
+  * @brief  在发送缓存中预留空间，供调用者直接写入（如帧编码），省去一次复制
+  *
+  * @param  port: 串口对象指针
+  * @param  num:  预留的字节数，不大于发送缓存大小
+  *
+  * @retval 写入位置pos，第i个字节写入port->txBuffer[(pos + i) & port->txMask]
+  *
+  * @note
+  * 只能用于有发送缓存的串口。空闲空间不足num字节时等待，计入txWait。
+  * 写入后调用UARTPortTxCommit提交，提交前不能调用同一串口的其他发送函数。
+  */
+uint16_t UARTPortTxReserve(UARTPort * port, uint16_t num)
+{
+  uint16_t head = port->txHead;
+
+  if(num != 0 && (uint16_t)(head + num - 1 - port->txTail) > port->txMask)
+    _UARTWait(port, head + num - 1);
+
+  return head;
+}
+
+/**
+  * @brief  提交UARTPortTxReserve预留后写入的数据，开始发送
+  *
+  * @param  port: 串口对象指针
+  * @param  num:  实际写入的字节数，不大于预留的字节数
+  *
+  * @retval None
+  */
+void UARTPortTxCommit(UARTPort * port, uint16_t num)
+{
+  port->txHead += num;
+  port->ops->TxIntEnable(port->hw, 1);
+  port->stats.txBytes += num;
+}
+
 /**
   * @brief  发送一个字符
   *
+  * @param  port: 串口对象指针
   * @param  c: 需要发送的字符
   *
   * @retval None
   */
-void UARTSendChar(const char c)
+void UARTPortSendChar(UARTPort * port, const char c)
 {
-  while(!HAL_UART_TX_READY);
-  HAL_UART_SEND_UINT8(c);
+  UART_STATS_BEGIN(port);
+
+  _UARTPut(port, c);
+
+  UART_STATS_END(port, UART_STATS_CHAR);
 }
 
 /**
   * @brief  发送一个二进制数据，以字节形式
   *
+  * @param  port: 串口对象指针
   * @param  UARTdata: 需要发送的数据
   *
   * @retval None
   */
-void UARTSendByte(const uint8_t UARTdata)
+void UARTPortSendByte(UARTPort * port, const uint8_t UARTdata)
 {
-  while(!HAL_UART_TX_READY);
-  HAL_UART_SEND_UINT8(UARTdata);
+  UART_STATS_BEGIN(port);
+
+  _UARTPut(port, UARTdata);
+
+  UART_STATS_END(port, UART_STATS_BYTE);
 }
 
 /**
   * @brief  发送一个二进制数据，以字(WORD, 2 Bytes)形式
   *
+  * @param  port: 串口对象指针
   * @param  UARTdata: 需要发送的数据
   *
   * @retval None
   *
   * @note   先发送高字节
   */
-void UARTSendWord(const uint16_t UARTdata)
+void UARTPortSendWord(UARTPort * port, const uint16_t UARTdata)
 {
-  while(!HAL_UART_TX_READY);
-  HAL_UART_SEND_UINT8((uint8_t)(UARTdata>>8 & 0x00FF));
-  while(!HAL_UART_TX_READY);
-  HAL_UART_SEND_UINT8((uint8_t)(UARTdata & 0x00FF));
+  UART_STATS_BEGIN(port);
+
+  _UARTPut(port, (uint8_t)(UARTdata>>8 & 0x00FF));
+  _UARTPut(port, (uint8_t)(UARTdata & 0x00FF));
+
+  UART_STATS_END(port, UART_STATS_WORD);
 }
 
 /**
   * @brief  发送一个二进制数据，以双字(DWORD, 4 Bytes)形式
   *
+  * @param  port: 串口对象指针
   * @param  UARTdata: 
   *
   * @retval 需要发送的数据
   *
   * @note   先发送高字节
   */
-void UARTSendDword(const uint32_t UARTdata)
+void UARTPortSendDword(UARTPort * port, const uint32_t UARTdata)
 {
-  while(!HAL_UART_TX_READY);
-  HAL_UART_SEND_UINT8((uint8_t)(UARTdata>>24 & 0x00FF));
-  while(!HAL_UART_TX_READY);
-  HAL_UART_SEND_UINT8((uint8_t)(UARTdata>>16 & 0x00FF));
-  while(!HAL_UART_TX_READY);
-  HAL_UART_SEND_UINT8((uint8_t)(UARTdata>>8 & 0x00FF));
-  while(!HAL_UART_TX_READY);
-  HAL_UART_SEND_UINT8((uint8_t)(UARTdata & 0x00FF));
+  UART_STATS_BEGIN(port);
+
+  _UARTPut(port, (uint8_t)(UARTdata>>24 & 0x00FF));
+  _UARTPut(port, (uint8_t)(UARTdata>>16 & 0x00FF));
+  _UARTPut(port, (uint8_t)(UARTdata>>8 & 0x00FF));
+  _UARTPut(port, (uint8_t)(UARTdata & 0x00FF));
+
+  UART_STATS_END(port, UART_STATS_DWORD);
 }
 
 
 /**
   * @brief  发送一个无符号二进制数据，以ASCII码形式
   *
+  * @param  port: 串口对象指针
   * @param  UARTdata: 需要发送的数据
   * @param  base:     数据进制，理论上支持2~36进制，常用值：
   *   @arg 2:   二进制
@@ -123,15 +361,31 @@ void UARTSendDword(const uint32_t UARTdata)
   *
   * @note
   * 若数据所需位数大于align值，将按实际位数输出，不会截短。
+  *
+  * @note
+  * 2、8、16进制通过移位和查表转换，10进制通过减法和两位数字表转换，
+  * 均不使用除法；其他进制仍使用 % base 和 /= base 的通用方法。
+  * 定义UART_ASCII_GENERIC后所有进制均使用通用方法，便于在目标平台上对比。
+  * 转换一个32位数据所需的运算次数（不含发送）：
+  * @verbatim
+  *   进制     通用方法                 快速方法
+  *   16       8次除法 + 8次取余        8次移位 + 8次查表
+  *   2        32次除法 + 32次取余      32次移位 + 32次查表
+  *   10       10次除法 + 10次取余      最多54次32位减法 + 1次16位乘法 + 2次查表
+  * @endverbatim
+  * C28x与8051上32位除法均为库函数调用，每次耗时为32位减法的数十倍以上。
   */
-void UARTSendUnsignASCII(uint32_t UARTdata, uint8_t base, uint8_t align)
+void UARTPortSendUnsignASCII(UARTPort * port, uint32_t UARTdata, uint8_t base, uint8_t align)
 {
 	/* 转换后的ASCII码 */
 	char str[32];
 	/* 计数变量 */
 	signed char i;
+#ifdef UART_ASCII_GENERIC
 	/* 临时变量 */
 	char c;
+#endif
+	UART_STATS_BEGIN(port);
 
 	/* 处理输入数据为0的情况 */
 	if(UARTdata == 0)
@@ -141,13 +395,14 @@ void UARTSendUnsignASCII(uint32_t UARTdata, uint8_t base, uint8_t align)
 			align = 1;
     for (; align > 0; align--)
     {
-      while (!HAL_UART_TX_READY);
-      HAL_UART_SEND_UINT8('0');
+      _UARTPut(port, '0');
     }
 
+		UART_STATS_END(port, UART_STATS_UNSIGN_ASCII);
 		return;
 	}
 
+#ifdef UART_ASCII_GENERIC
 	/* 逆序获得ASCII码，不断 % base */
 	for(i = 0; UARTdata > 0; i++, UARTdata /= base)
 	{
@@ -159,26 +414,47 @@ void UARTSendUnsignASCII(uint32_t UARTdata, uint8_t base, uint8_t align)
 			/* 如果数字大于等于10，将数字减去10再加上'A' */
 			str[i] = c - 10 + 'A';
 	}
+#else
+	switch(base)
+	{
+	case 2:
+		i = _UARTPow2ToStr(UARTdata, 1, str);
+		break;
+	case 8:
+		i = _UARTPow2ToStr(UARTdata, 3, str);
+		break;
+	case 16:
+		i = _UARTPow2ToStr(UARTdata, 4, str);
+		break;
+	case 10:
+		i = _UARTDecToStr(UARTdata, str);
+		break;
+	default:
+		i = _UARTBaseToStr(UARTdata, base, str);
+		break;
+	}
+#endif
 
 	/* 补0对齐数据 */
 	if(i < align)
 		for(;align > i;align--)
     {
-      while (!HAL_UART_TX_READY);
-      HAL_UART_SEND_UINT8('0');
+      _UARTPut(port, '0');
     }
 
 	/* 逆序发送转换得到的ASCII码 */
 	for(--i;i >= 0;i--)
   {
-    while (!HAL_UART_TX_READY);
-    HAL_UART_SEND_UINT8(str[i]);
+    _UARTPut(port, str[i]);
   }
+
+	UART_STATS_END(port, UART_STATS_UNSIGN_ASCII);
 }
 
 /**
   * @brief  发送一个带符号二进制数据，以ASCII码形式
   *
+  * @param  port: 串口对象指针
   * @param  UARTdata: 需要发送的数据
   * @param  align:    是否需要对齐
   *   @arg 0:     无需对齐
@@ -190,111 +466,680 @@ void UARTSendUnsignASCII(uint32_t UARTdata, uint8_t base, uint8_t align)
   * 若数据所需位数大于align值，将按实际位数输出，不会截短。
   * 此处的位数是指数据的位数，不包括前面的符号位。
   */
-void UARTSendSignASCII(int32_t UARTdata, uint8_t align)
+void UARTPortSendSignASCII(UARTPort * port, int32_t UARTdata, uint8_t align)
 {
+	UART_STATS_BEGIN(port);
+
 	if(UARTdata < 0)
 	{
-    while (!HAL_UART_TX_READY);
-    HAL_UART_SEND_UINT8('-');
-		UARTSendUnsignASCII((uint32_t)(-UARTdata), 10, align);
+    _UARTPut(port, '-');
+		UARTPortSendUnsignASCII(port, (uint32_t)(-UARTdata), 10, align);
 	}
 	else
 	{
-    while (!HAL_UART_TX_READY);
-    HAL_UART_SEND_UINT8('+');
-		UARTSendUnsignASCII((uint32_t)(UARTdata), 10, align);
+    _UARTPut(port, '+');
+		UARTPortSendUnsignASCII(port, (uint32_t)(UARTdata), 10, align);
 	}
+
+	UART_STATS_END(port, UART_STATS_SIGN_ASCII);
+}
+
+/**
+  * @brief  发送一个定点数(Qm.n)，以十进制小数形式
+  *
+  * @param  port: 串口对象指针
+  * @param  UARTdata: 需要发送的定点数，实际值为UARTdata / 2^frac
+  * @param  frac:     小数位数n（二进制），0~31，如Q15为15、IQ24为24
+  * @param  prec:     输出的小数位数（十进制），0~9，末位四舍五入
+  *
+  * @retval void
+  *
+  * @note
+  * 与UARTSendSignASCII相同，正数前有'+'号。
+  * 小数部分每位只需一次乘10（移位加法）、一次移位和一次与运算，不使用除法；
+  * frac大于28时只取最高28位小数参与转换，误差小于4e-9。
+  */
+void UARTPortSendFixed(UARTPort * port, int32_t UARTdata, uint8_t frac, uint8_t prec)
+{
+  uint32_t abs;
+  uint8_t neg;
+  UART_STATS_BEGIN(port);
+
+  neg = UARTdata < 0;
+  abs = neg ? 0 - (uint32_t)UARTdata : (uint32_t)UARTdata;
+  if(frac > 31)
+    frac = 31;
+
+  if(frac > 28)
+    _UARTSendFrac(port, neg, abs >> frac, (abs & (((uint32_t)1 << frac) - 1)) >> (frac - 28), 28, prec);
+  else
+    _UARTSendFrac(port, neg, abs >> frac, abs & (((uint32_t)1 << frac) - 1), frac, prec);
+
+  UART_STATS_END(port, UART_STATS_FIXED);
+}
+
+#ifndef UART_NO_FLOAT
+/**
+  * @brief  发送一个单精度浮点数，以十进制小数形式
+  *
+  * @param  port: 串口对象指针
+  * @param  UARTdata: 需要发送的浮点数
+  * @param  prec:     输出的小数位数，0~9，末位四舍五入
+  *
+  * @retval void
+  *
+  * @note
+  * 直接从IEEE 754位模式中取出尾数和指数，转换为定点数后按UARTSendFixed的方法输出，
+  * 不进行任何浮点运算，也不需要libm。
+  * 正数前有'+'号；非数输出"nan"，无穷大输出"+inf"/"-inf"，
+  * 绝对值不小于2^32时输出"+ovf"/"-ovf"。
+  * 绝对值小于2^-5时只取28位二进制小数参与转换，误差小于4e-9。
+  */
+void UARTPortSendFloat(UARTPort * port, float UARTdata, uint8_t prec)
+{
+  uint32_t bits, m;
+  int16_t e;
+  uint8_t neg, shift;
+  UART_STATS_BEGIN(port);
+
+  memcpy(&bits, &UARTdata, sizeof(bits));
+  neg = (uint8_t)(bits >> 31);
+  e = (int16_t)(bits >> 23 & 0xFF);
+  m = bits & 0x007FFFFF;
+
+  if(e == 0xFF)
+  {
+    /* 非数或无穷大 */
+    if(m != 0)
+      UARTPortSendString(port, "nan");
+    else
+      UARTPortSendString(port, neg ? "-inf" : "+inf");
+  }
+  else
+  {
+    /* 值为m * 2^(e - 23)，非规格化数没有隐含的最高位 */
+    if(e == 0)
+      e = -126;
+    else
+    {
+      m |= 0x00800000;
+      e -= 127;
+    }
+
+    if(e >= 32)
+      UARTPortSendString(port, neg ? "-ovf" : "+ovf");
+    else if(e >= 23)
+      _UARTSendFrac(port, neg, m << (e - 23), 0, 0, prec);
+    else if(23 - e <= 28)
+    {
+      shift = (uint8_t)(23 - e);
+      _UARTSendFrac(port, neg, m >> shift, m & (((uint32_t)1 << shift) - 1), shift, prec);
+    }
+    else
+    {
+      /* 整数部分为0，尾数右移到28位小数 */
+      shift = 23 - e - 28 < 32 ? (uint8_t)(23 - e - 28) : 31;
+      _UARTSendFrac(port, neg, 0, m >> shift, 28, prec);
+    }
+  }
+
+  UART_STATS_END(port, UART_STATS_FLOAT);
 }
+#endif
 
 
 /**
   * @brief  发送字符串
   *
+  * @param  port: 串口对象指针
   * @param  str: 字符串头指针
   *
   * @retval void
   *
   * @note   字符串需以'\0'结尾
   */
-void UARTSendString(const char * str)
+void UARTPortSendString(UARTPort * port, const char * str)
 {
+    UART_STATS_BEGIN(port);
+
     for(; *str != '\0'; str++)
     {
-      while (!HAL_UART_TX_READY);
-      HAL_UART_SEND_UINT8(*str);
+      _UARTPut(port, *str);
     }
+
+    UART_STATS_END(port, UART_STATS_STRING);
 }
 
 /**
   * @brief  发送二进制数据数组，以字节形式
   *
+  * @param  port: 串口对象指针
   * @param  UARTdata: 数组头指针
   * @param  num:      数组中数据个数
   *
   * @retval void
   */
-void UARTSendByteArray(const uint8_t * UARTdata, const uint16_t num)
+void UARTPortSendByteArray(UARTPort * port, const uint8_t * UARTdata, const uint16_t num)
 {
-    uint16_t count = 0;
-    for(; count < num; count++, UARTdata++)
-    {
-      while (!HAL_UART_TX_READY);
-      HAL_UART_SEND_UINT8(*UARTdata);
-    }
+    UART_STATS_BEGIN(port);
+
+    _UARTPutBlock(port, UARTdata, num);
+
+    UART_STATS_END(port, UART_STATS_BYTE_ARRAY);
 }
 
 /**
   * @brief  发送二进制数据数组，以字(WORD, 2 Bytes)形式
   *
+  * @param  port: 串口对象指针
   * @param  UARTdata: 数组头指针
   * @param  num:      数组中数据个数
   *
   * @retval void
   *
-  * @note   先发送高字节
+  * @note
+  * 先发送高字节。每次将UART_SWAP_BUFFER_SIZE字节转换到暂存区后整段发送。
   */
-void UARTSendWordArray(const uint16_t * UARTdata, const uint16_t num)
+void UARTPortSendWordArray(UARTPort * port, const uint16_t * UARTdata, const uint16_t num)
 {
-	uint16_t count = 0;
-	for(; count < num; count++, UARTdata++)
-	{
-    while (!HAL_UART_TX_READY);
-    HAL_UART_SEND_UINT8((uint8_t)(*UARTdata >> 8 & 0x00FF));
-    while (!HAL_UART_TX_READY);
-    HAL_UART_SEND_UINT8((uint8_t)(*UARTdata & 0x00FF));
-	}
+    uint8_t stage[UART_SWAP_BUFFER_SIZE];
+    uint16_t remain = num;
+    uint16_t n;
+    UART_STATS_BEGIN(port);
+
+    while(remain != 0)
+    {
+      n = remain < UART_SWAP_BUFFER_SIZE / 2 ? remain : UART_SWAP_BUFFER_SIZE / 2;
+      _UARTSwapWord(stage, UARTdata, n);
+      _UARTPutBlock(port, stage, n * 2);
+      UARTdata += n;
+      remain -= n;
+    }
+
+    UART_STATS_END(port, UART_STATS_WORD_ARRAY);
 }
 
 /**
   * @brief  发送二进制数据数组，以双字(DWORD, 4 Bytes)形式
   *
+  * @param  port: 串口对象指针
   * @param  UARTdata: 数组头指针
   * @param  num:      数组中数据个数
   *
   * @retval void
   *
-  * @note   先发送高字节
+  * @note
+  * 先发送高字节。每次将UART_SWAP_BUFFER_SIZE字节转换到暂存区后整段发送。
+  */
+void UARTPortSendDwordArray(UARTPort * port, const uint32_t * UARTdata, const uint16_t num)
+{
+    uint8_t stage[UART_SWAP_BUFFER_SIZE];
+    uint16_t remain = num;
+    uint16_t n;
+    UART_STATS_BEGIN(port);
+
+    while(remain != 0)
+    {
+      n = remain < UART_SWAP_BUFFER_SIZE / 4 ? remain : UART_SWAP_BUFFER_SIZE / 4;
+      _UARTSwapDword(stage, UARTdata, n);
+      _UARTPutBlock(port, stage, n * 4);
+      UARTdata += n;
+      remain -= n;
+    }
+
+    UART_STATS_END(port, UART_STATS_DWORD_ARRAY);
+}
+
+/**
+  * @brief  字数组转换为高字节在前的字节序列
+  */
+static void _UARTSwapWord(uint8_t * out, const uint16_t * in, uint16_t num)
+{
+#ifdef UART_SWAP_BUILTIN
+  uint16_t v;
+
+  /* 开启-O3时GCC可将此循环向量化为SIMD字节重排指令 */
+  for(; num != 0; num--, in++, out += 2)
+  {
+    v = __builtin_bswap16(*in);
+    memcpy(out, &v, 2);
+  }
+#else
+  uint16_t v;
+
+  /* 每个字只读取一次；C28x等char为16位的平台，每个uint8_t单元存放一个字节 */
+  for(; num != 0; num--, in++, out += 2)
+  {
+    v = *in;
+    out[0] = (uint8_t)(v >> 8 & 0x00FF);
+    out[1] = (uint8_t)(v & 0x00FF);
+  }
+#endif
+}
+
+/**
+  * @brief  双字数组转换为高字节在前的字节序列
+  */
+static void _UARTSwapDword(uint8_t * out, const uint32_t * in, uint16_t num)
+{
+#ifdef UART_SWAP_BUILTIN
+  uint32_t v;
+
+  for(; num != 0; num--, in++, out += 4)
+  {
+    v = __builtin_bswap32(*in);
+    memcpy(out, &v, 4);
+  }
+#else
+  uint32_t v;
+  uint16_t hi, lo;
+
+  /* 拆成两个16位字处理，16位和8位平台上避免32位移位 */
+  for(; num != 0; num--, in++, out += 4)
+  {
+    v = *in;
+    hi = (uint16_t)(v >> 16);
+    lo = (uint16_t)v;
+    out[0] = (uint8_t)(hi >> 8 & 0x00FF);
+    out[1] = (uint8_t)(hi & 0x00FF);
+    out[2] = (uint8_t)(lo >> 8 & 0x00FF);
+    out[3] = (uint8_t)(lo & 0x00FF);
+  }
+#endif
+}
+
+/**
+  * @brief  发送一段数据
+  *
+  * @note
+  * 无发送缓存且底层支持整段发送时交给SendBlock，data可能是调用者栈上的暂存区，
+  * 按UARTPortOps的约定SendBlock返回时已用完；
+  * 有发送缓存时按缓存中连续空闲空间分段复制，每段只打开一次发送中断；
+  * 否则逐字节发送。
+  */
+static void _UARTPutBlock(UARTPort * port, const uint8_t * data, uint16_t num)
+{
+  uint16_t head, space, n;
+
+  if(port->txBuffer == 0)
+  {
+    if(port->ops->SendBlock != 0)
+    {
+      port->ops->SendBlock(port->hw, data, num);
+      port->stats.txBytes += num;
+    }
+    else
+    {
+      for(; num != 0; num--, data++)
+        _UARTPut(port, *data);
+    }
+    return;
+  }
+
+  while(num != 0)
+  {
+    head = port->txHead;
+    space = port->txMask + 1 - (uint16_t)(head - port->txTail);
+    if(space == 0)
+    {
+      _UARTWait(port, head);
+      continue;
+    }
+
+    /* 不超过缓存末尾 */
+    n = port->txMask + 1 - (head & port->txMask);
+    if(n > space)
+      n = space;
+    if(n > num)
+      n = num;
+
+    memcpy(port->txBuffer + (head & port->txMask), data, n);
+    port->txHead = head + n;
+    port->ops->TxIntEnable(port->hw, 1);
+
+    port->stats.txBytes += n;
+    data += n;
+    num -= n;
+  }
+}
+
+/**
+  * @brief  发送一个字节，所有发送函数最终都通过此函数发送
+  */
+static void _UARTPut(UARTPort * port, uint8_t c)
+{
+  uint16_t head;
+
+  if(port->txBuffer == 0)
+  {
+    /* 无发送缓存，等待发送寄存器可写 */
+    if(!port->ops->TxReady(port->hw))
+      _UARTWait(port, 0);
+    port->ops->SendUint8(port->hw, c);
+  }
+  else
+  {
+    /* 写入发送缓存，缓存满时等待发送中断取走数据 */
+    head = port->txHead;
+    if((uint16_t)(head - port->txTail) > port->txMask)
+      _UARTWait(port, head);
+    port->txBuffer[head & port->txMask] = c;
+    port->txHead = head + 1;
+    port->ops->TxIntEnable(port->hw, 1);
+  }
+
+  port->stats.txBytes++;
+}
+
+/**
+  * @brief  发送定点数，整数部分为ip，小数部分为f / 2^frac
+  *
+  * @param  neg:  是否为负数
+  * @param  ip:   整数部分
+  * @param  f:    小数部分，小于2^frac
+  * @param  frac: 小数部分的二进制位数，0~28，保证f * 10不超过32位
+  * @param  prec: 输出的小数位数，大于9时按9处理
+  */
+static void _UARTSendFrac(UARTPort * port, uint8_t neg, uint32_t ip, uint32_t f, uint8_t frac, uint8_t prec)
+{
+  char str[9];
+  uint32_t mask = ((uint32_t)1 << frac) - 1;
+  uint8_t i;
+
+  if(prec > 9)
+    prec = 9;
+
+  /* 逐位取出十进制小数：乘10后整数部分即为下一位 */
+  for(i = 0; i < prec; i++)
+  {
+    f = (f << 3) + (f << 1);
+    str[i] = (char)('0' + (f >> frac));
+    f &= mask;
+  }
+
+  /* 剩余部分不小于0.5时进位，可能进位到整数部分 */
+  if(frac != 0 && (f >> (frac - 1)) != 0)
+  {
+    for(i = prec; i > 0; i--)
+    {
+      if(str[i - 1] != '9')
+      {
+        str[i - 1]++;
+        break;
+      }
+      str[i - 1] = '0';
+    }
+    if(i == 0)
+      ip++;
+  }
+
+  _UARTPut(port, neg ? '-' : '+');
+  UARTPortSendUnsignASCII(port, ip, 10, 0);
+  if(prec != 0)
+  {
+    _UARTPut(port, '.');
+    for(i = 0; i < prec; i++)
+      _UARTPut(port, str[i]);
+  }
+}
+
+/**
+  * @brief  等待发送寄存器可写（无发送缓存）或发送缓存有空闲（head为当前写入位置）
+  */
+static void _UARTWait(UARTPort * port, uint16_t head)
+{
+#ifdef UART_STATS
+  uint32_t start = UART_STATS_CYCLES();
+  uint32_t cycles;
+#endif
+
+  port->stats.txWait++;
+  if(port->txBuffer == 0)
+    while(!port->ops->TxReady(port->hw));
+  else
+    while((uint16_t)(head - port->txTail) > port->txMask);
+
+#ifdef UART_STATS
+  cycles = UART_STATS_CYCLES() - start;
+  UART_STATS_ADD(port->stats.waitCycles, cycles);
+  UART_STATS_ADD(port->stats.callWait, cycles);
+#endif
+}
+
+#ifdef UART_STATS
+/**
+  * @brief  发送函数开始，记录计数值
+  */
+static void _UARTStatsBegin(UARTPort * port, UARTStatsMark * mark)
+{
+  mark->outer = port->stats.depth++ == 0;
+  mark->bytes = port->stats.txBytes;
+  if(mark->outer)
+    port->stats.callWait = 0;
+  mark->start = UART_STATS_CYCLES();
+}
+
+/**
+  * @brief  发送函数结束，最外层函数计入统计信息
+  */
+static void _UARTStatsEnd(UARTPort * port, const UARTStatsMark * mark, UARTStatsFunc func)
+{
+  uint32_t cycles = UART_STATS_CYCLES() - mark->start;
+  UARTFuncStats * st = &port->stats.func[func];
+
+  port->stats.depth--;
+  if(!mark->outer)
+    return;
+
+  st->calls++;
+  st->bytes += port->stats.txBytes - mark->bytes;
+  UART_STATS_ADD(st->cycles, cycles);
+  if(cycles > st->maxCycles)
+    st->maxCycles = cycles;
+  UART_STATS_ADD(st->waitCycles, port->stats.callWait);
+}
+#endif
+
+#ifndef UART_NO_DEFAULT_PORT
+/**
+  * @brief  发送一个字符，使用默认串口，见UARTPortSendChar
+  */
+void UARTSendChar(const char c)
+{
+  UARTPortSendChar(&UARTDefaultPort, c);
+}
+
+/**
+  * @brief  发送一个二进制数据，以字节形式，使用默认串口，见UARTPortSendByte
+  */
+void UARTSendByte(const uint8_t UARTdata)
+{
+  UARTPortSendByte(&UARTDefaultPort, UARTdata);
+}
+
+/**
+  * @brief  发送一个二进制数据，以字形式，使用默认串口，见UARTPortSendWord
+  */
+void UARTSendWord(const uint16_t UARTdata)
+{
+  UARTPortSendWord(&UARTDefaultPort, UARTdata);
+}
+
+/**
+  * @brief  发送一个二进制数据，以双字形式，使用默认串口，见UARTPortSendDword
+  */
+void UARTSendDword(const uint32_t UARTdata)
+{
+  UARTPortSendDword(&UARTDefaultPort, UARTdata);
+}
+
+/**
+  * @brief  发送一个无符号二进制数据，以ASCII码形式，使用默认串口，见UARTPortSendUnsignASCII
+  */
+void UARTSendUnsignASCII(uint32_t UARTdata, uint8_t base, uint8_t align)
+{
+  UARTPortSendUnsignASCII(&UARTDefaultPort, UARTdata, base, align);
+}
+
+/**
+  * @brief  发送一个带符号二进制数据，以ASCII码形式，使用默认串口，见UARTPortSendSignASCII
+  */
+void UARTSendSignASCII(int32_t UARTdata, uint8_t align)
+{
+  UARTPortSendSignASCII(&UARTDefaultPort, UARTdata, align);
+}
+
+/**
+  * @brief  发送一个定点数(Qm.n)，使用默认串口，见UARTPortSendFixed
+  */
+void UARTSendFixed(int32_t UARTdata, uint8_t frac, uint8_t prec)
+{
+  UARTPortSendFixed(&UARTDefaultPort, UARTdata, frac, prec);
+}
+
+#ifndef UART_NO_FLOAT
+/**
+  * @brief  发送一个单精度浮点数，使用默认串口，见UARTPortSendFloat
+  */
+void UARTSendFloat(float UARTdata, uint8_t prec)
+{
+  UARTPortSendFloat(&UARTDefaultPort, UARTdata, prec);
+}
+#endif
+
+/**
+  * @brief  发送字符串，使用默认串口，见UARTPortSendString
+  */
+void UARTSendString(const char * str)
+{
+  UARTPortSendString(&UARTDefaultPort, str);
+}
+
+/**
+  * @brief  发送二进制数据数组，以字节形式，使用默认串口，见UARTPortSendByteArray
+  */
+void UARTSendByteArray(const uint8_t * UARTdata, const uint16_t num)
+{
+  UARTPortSendByteArray(&UARTDefaultPort, UARTdata, num);
+}
+
+/**
+  * @brief  发送二进制数据数组，以字形式，使用默认串口，见UARTPortSendWordArray
+  */
+void UARTSendWordArray(const uint16_t * UARTdata, const uint16_t num)
+{
+  UARTPortSendWordArray(&UARTDefaultPort, UARTdata, num);
+}
+
+/**
+  * @brief  发送二进制数据数组，以双字形式，使用默认串口，见UARTPortSendDwordArray
   */
 void UARTSendDwordArray(const uint32_t * UARTdata, const uint16_t num)
 {
-	uint16_t count = 0;
-	for(; count < num; count++, UARTdata++)
-	{
-    while (!HAL_UART_TX_READY);
-    HAL_UART_SEND_UINT8((uint8_t)(*UARTdata >> 24 & 0x00FF));
-    while (!HAL_UART_TX_READY);
-    HAL_UART_SEND_UINT8((uint8_t)(*UARTdata >> 16 & 0x00FF));
-    while (!HAL_UART_TX_READY);
-    HAL_UART_SEND_UINT8((uint8_t)(*UARTdata >> 8 & 0x00FF));
-    while (!HAL_UART_TX_READY);
-    HAL_UART_SEND_UINT8((uint8_t)(*UARTdata & 0x00FF));
-	}
+  UARTPortSendDwordArray(&UARTDefaultPort, UARTdata, num);
+}
+#endif
+
+#ifndef UART_ASCII_GENERIC
+/**
+  * @brief  2的幂次进制转换，逆序存入str
+  *
+  * @param  UARTdata: 需要转换的数据，不为0
+  * @param  shift:    每位数字对应的二进制位数，1、3、4分别对应2、8、16进制
+  * @param  str:      转换结果，低位在前
+  *
+  * @retval 转换得到的数字个数
+  */
+static signed char _UARTPow2ToStr(uint32_t UARTdata, uint8_t shift, char * str)
+{
+  signed char i;
+  uint8_t mask = (1 << shift) - 1;
+
+  for(i = 0; UARTdata > 0; i++, UARTdata >>= shift)
+    str[i] = _UARTDigitTable[(uint8_t)UARTdata & mask];
+
+  return i;
 }
 
+/**
+  * @brief  十进制转换，逆序存入str
+  *
+  * @param  UARTdata: 需要转换的数据，不为0
+  * @param  str:      转换结果，低位在前
+  *
+  * @retval 转换得到的数字个数
+  *
+  * @note
+  * 高6位通过连续减去权值得到，每位最多减9次；
+  * 低4位小于10000，用 (x * 5243) >> 19 代替 x / 100，再查两位数字表。
+  */
+static signed char _UARTDecToStr(uint32_t UARTdata, char * str)
+{
+  signed char i;
+  uint8_t k;
+  char d;
+  uint16_t low, high;
+
+  /* 高6位，依次存入str[9]~str[4] */
+  for(k = 0; k < 6; k++)
+  {
+    d = '0';
+    while(UARTdata >= _UARTDecPow10[k])
+    {
+      UARTdata -= _UARTDecPow10[k];
+      d++;
+    }
+    str[9 - k] = d;
+  }
+
+  /* 低4位，每次处理两位 */
+  low = (uint16_t)UARTdata;
+  high = (uint16_t)(((uint32_t)low * 5243) >> 19);
+  low = low - high * 100;
+  str[0] = _UARTDec2Table[2 * low + 1];
+  str[1] = _UARTDec2Table[2 * low];
+  str[2] = _UARTDec2Table[2 * high + 1];
+  str[3] = _UARTDec2Table[2 * high];
+
+  /* 去掉高位的0 */
+  for(i = 10; i > 1 && str[i - 1] == '0'; i--);
+
+  return i;
+}
+
+/**
+  * @brief  通用进制转换，逆序存入str
+  *
+  * @param  UARTdata: 需要转换的数据，不为0
+  * @param  base:     数据进制
+  * @param  str:      转换结果，低位在前
+  *
+  * @retval 转换得到的数字个数
+  */
+static signed char _UARTBaseToStr(uint32_t UARTdata, uint8_t base, char * str)
+{
+  signed char i;
+  char c;
+
+  /* 逆序获得ASCII码，不断 % base */
+  for(i = 0; UARTdata > 0; i++, UARTdata /= base)
+  {
+    c = UARTdata % base;
+    if(c < 10)
+      str[i] = c + '0';
+    else
+      str[i] = c - 10 + 'A';
+  }
+
+  return i;
+}
+#endif
+
 #ifndef UART_LEGACY
 /**
   * @brief  简易版printf函数
   *
+  * @param  port:   串口对象指针
   * @param  format: 格式化字符串，支持的占位符：
   *   @arg %d: 带符号整数
   *   @arg %u: 无符号整数, 十进制形式
@@ -302,21 +1147,56 @@ void UARTSendDwordArray(const uint32_t * UARTdata, const uint16_t num)
   *   @arg %b: 无符号整数, 二进制形式, 自动补足至8、16、32位
   *   @arg %c: 一个ASCII字符
   *   @arg %s: 字符串
+  *   @arg %f: 浮点数, 小数位数为UART_FLOAT_PRECISION, 见UARTPortSendFloat
+  *   @arg %.Nf: 浮点数, N位小数, N为0~9
   *
   * @retval void
   *
   * @warning
-  * 输入的数字类型必须为uint32_t，否则会发生错误
+  * 输入的数字类型必须为uint32_t，否则会发生错误；%f的参数为float或double，
+  * 按可变参数规则以double传入后转换为float，精度为单精度
+  *
+  * @note
+  * C++中可使用UARTPrintf.hpp中的UART_PRINTF，格式化字符串在编译期解析，参数类型在编译期检查
   */
-void UARTprintf(const char *format, ...)
+void UARTPortPrintf(UARTPort * port, const char *format, ...)
 {
 	/* 可变参数指针 */
 	va_list ap;
-	/* 临时变量 */
-	uint32_t tmp;
 
 	/* 初始化va_list类型的变量ap，使ap指向第一个可变参数 */
 	va_start(ap, format);
+	_UARTVprintf(port, format, ap);
+	/* 将ap置空 */
+	va_end(ap);
+}
+
+#ifndef UART_NO_DEFAULT_PORT
+/**
+  * @brief  简易版printf函数，使用默认串口
+  *
+  * @param  format: 格式化字符串，见UARTPortPrintf
+  *
+  * @retval void
+  */
+void UARTprintf(const char *format, ...)
+{
+	va_list ap;
+
+	va_start(ap, format);
+	_UARTVprintf(&UARTDefaultPort, format, ap);
+	va_end(ap);
+}
+#endif
+
+/**
+  * @brief  printf的实现
+  */
+static void _UARTVprintf(UARTPort * port, const char *format, va_list ap)
+{
+	/* 临时变量 */
+	uint32_t tmp;
+	UART_STATS_BEGIN(port);
 
 	/* 依次处理字符串中的每个字符 */
 	for(; *format != '\0'; format++)
@@ -324,8 +1204,7 @@ void UARTprintf(const char *format, ...)
 		if(*format != '%')
 		{
 			/* 一般字符，按常规字符发送即可 */
-      while (!HAL_UART_TX_READY);
-      HAL_UART_SEND_UINT8(*format);
+      _UARTPut(port, *format);
 			continue;
 		}
 		else
@@ -335,49 +1214,63 @@ void UARTprintf(const char *format, ...)
 			switch(*(++format)) /* 跳过%号 */
 			{
 			case 'd':
-				UARTSendSignASCII(va_arg(ap, uint32_t), 0);
+				UARTPortSendSignASCII(port, va_arg(ap, uint32_t), 0);
 				break;
 			case 'u':
 				tmp = va_arg(ap, uint32_t);
-				UARTSendUnsignASCII(tmp, 10, 0);
+				UARTPortSendUnsignASCII(port, tmp, 10, 0);
 				break;
 			case 'x':
 				tmp = va_arg(ap, uint32_t);
 				if(tmp <= 0xFF)
-					UARTSendUnsignASCII(tmp, 16, 2);
+					UARTPortSendUnsignASCII(port, tmp, 16, 2);
 				else if(tmp <= 0xFFFF)
-					UARTSendUnsignASCII(tmp, 16, 4);
+					UARTPortSendUnsignASCII(port, tmp, 16, 4);
 				else
-					UARTSendUnsignASCII(tmp, 16, 8);
+					UARTPortSendUnsignASCII(port, tmp, 16, 8);
 				break;
 			case 'b':
 				tmp = va_arg(ap, uint32_t);
 				if(tmp <= 0xFF)
-					UARTSendUnsignASCII(tmp, 2, 8);
+					UARTPortSendUnsignASCII(port, tmp, 2, 8);
 				else if(tmp <= 0xFFFF)
-					UARTSendUnsignASCII(tmp, 2, 16);
+					UARTPortSendUnsignASCII(port, tmp, 2, 16);
 				else
-					UARTSendUnsignASCII(tmp, 2, 32);
+					UARTPortSendUnsignASCII(port, tmp, 2, 32);
 				break;
 			case 'c':
-				UARTSendChar(va_arg(ap, char));
+				/* char作为可变参数传递时被提升为int */
+				_UARTPut(port, (char)va_arg(ap, int));
 				break;
 			case 's':
-				UARTSendString(va_arg(ap, char *));
+				UARTPortSendString(port, va_arg(ap, char *));
+				break;
+#ifndef UART_NO_FLOAT
+			case 'f':
+				UARTPortSendFloat(port, (float)va_arg(ap, double), UART_FLOAT_PRECISION);
+				break;
+			case '.':
+				/* %.Nf */
+				if(format[1] >= '0' && format[1] <= '9' && format[2] == 'f')
+				{
+					UARTPortSendFloat(port, (float)va_arg(ap, double), (uint8_t)(format[1] - '0'));
+					format += 2;
+					break;
+				}
+				_UARTPut(port, '%');
+				_UARTPut(port, '.');
 				break;
+#endif
 			default:
 				/* 遇到未定义占位符按字符原样发送 */
-        while (!HAL_UART_TX_READY);
-        HAL_UART_SEND_UINT8('%');
-        while (!HAL_UART_TX_READY);
-        HAL_UART_SEND_UINT8(*format);
+        _UARTPut(port, '%');
+        _UARTPut(port, *format);
 				break;
 			}
 		}
 	}
 
-	/* 将ap置空 */
-	va_end(ap);
+	UART_STATS_END(port, UART_STATS_PRINTF);
 }
 
 /**
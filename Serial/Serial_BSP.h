@@ -24,10 +24,43 @@
   *   - 进一步修改注释格式。
   * 2015-11-26 :
   *   - 去掉内联函数inline（因为很多编译器对此的支持均有问题）
+  * 2026-10-18 :
+  *   - UARTSendUnsignASCII中2、8、10、16进制改为不使用除法的转换方法
+  *   - 添加UART_ASCII_GENERIC宏定义
+  *   - 添加UARTPort串口对象，支持多个串口同时使用，每个串口有独立的发送缓存和统计信息
+  *   - 原有函数改为使用默认串口UARTDefaultPort
+  *   - 添加SERIAL_HOST编译选项，支持在Linux主机上运行
+  *   - UARTPortOps增加SendBlock，UARTPortSendByteArray可整段发送
+  *   - 添加UART_SWAP_BUFFER_SIZE宏定义，字/双字数组整段发送
+  *   - 添加UART_STATS宏定义及UARTPortStatsReset，可统计各发送函数的耗时
+  *   - 添加UARTSendFixed、UARTSendFloat及printf的%f，添加UART_NO_FLOAT、UART_FLOAT_PRECISION宏定义
+  *   - 包含TypeDef.h，ErrorStatus等类型不再需要使用者预先定义
+  *   - 注明SendBlock返回前必须已用完数据
+  *   - UART_STATS的耗时累计值改为饱和累加，不再回绕
+  *   - 添加UARTPortTxReserve、UARTPortTxCommit，可直接写入发送缓存
   * @endverbatim
   *
   * @note
   * 程序中未包含具体的底层实现方法，在使用时需要根据具体平台改写相关宏定义。
+  *
+  * @note
+  * 多个串口同时使用时，为每个串口实现一组UARTPortOps，并调用UARTPortInit初始化，
+  * 之后使用UARTPortSend*系列函数。以TMS320F28027的SCIA为例：
+  * @verbatim
+  *   static void SciSend(void * hw, uint8_t c)
+  *   { ((volatile struct SCI_REGS *)hw)->SCITXBUF = c; }
+  *   static uint8_t SciReady(void * hw)
+  *   { return ((volatile struct SCI_REGS *)hw)->SCICTL2.bit.TXRDY; }
+  *   static void SciTxInt(void * hw, uint8_t enable)
+  *   { ((volatile struct SCI_REGS *)hw)->SCICTL2.bit.TXINTENA = enable; }
+  *   static const UARTPortOps SciOps = { SciSend, SciReady, SciTxInt };
+  *
+  *   static uint8_t DebugTxBuffer[256];
+  *   UARTPort DebugPort;
+  *   UARTPortInit(&DebugPort, &SciOps, (void *)&SciaRegs, DebugTxBuffer, sizeof(DebugTxBuffer));
+  *
+  *   __interrupt void SciaTxISR(void) { UARTPortTxISR(&DebugPort); ... }
+  * @endverbatim
   ***************************************************************
   */
  
@@ -48,11 +81,38 @@ extern "C" {
 /* 编译选项开关，部分编译器（如51）不支持va_list等，此时不实现printf() */
 //#define UART_LEGACY
 
-/* 如未定义uint8_t等基本数据类型，需要先定义 */
-//#include "TypeDef.h"
+/* 编译选项开关，定义后UARTSendUnsignASCII对所有进制均使用除法转换（原实现），
+ * 可用于在目标平台上对比转换耗时 */
+//#define UART_ASCII_GENERIC
+
+/* 编译选项开关，定义后不提供默认串口UARTDefaultPort及原有的UARTSend*函数，
+ * 此时不需要下面的HAL宏定义 */
+//#define UART_NO_DEFAULT_PORT
+
+/* 编译选项开关，定义后统计每个发送函数的调用次数、字节数、耗时及等待发送的耗时，
+ * 见UARTPortStats.func，需要下面的UART_STATS_CYCLES() */
+//#define UART_STATS
+
+/* 编译选项开关，定义后不提供UARTSendFloat及printf的%f，用于不支持浮点数的编译器 */
+//#define UART_NO_FLOAT
+
+/* printf中%f默认的小数位数，%.Nf可指定0~9位 */
+#define UART_FLOAT_PRECISION 3
+
+/* 字/双字数组发送时转换字节序使用的暂存区大小（字节），位于栈上，需为4的倍数 */
+#define UART_SWAP_BUFFER_SIZE 64
+
+/* 如未定义uint8_t等基本数据类型，需要先定义；SERIAL_HOST时由Serial_Host.h包含 */
+#ifndef SERIAL_HOST
+#include "TypeDef.h"
+#endif
 
 /* HAL层提供的UART底层实现宏定义，此处以TMS320F28027为例，需要根据实际情况修改 */
 
+#ifdef SERIAL_HOST
+/* Linux主机环境，见Host/Serial_Host.h，其中已定义下面的HAL宏 */
+#include "Serial_Host.h"
+#else
 /* HAL头文件 */
 #include "System.h"
 #include "UART.h"
@@ -70,9 +130,172 @@ extern "C" {
   * 当宏的值为0时，代表此时不能发送新数据。
   */
 #define HAL_UART_TX_READY (SciaRegs.SCICTL2.bit.TXRDY)
+#endif
+
+#if defined(UART_STATS) && !defined(UART_STATS_CYCLES)
+/**
+  * 读取32位递增计数器，用于UART_STATS计时，单位由计数器决定。
+  */
+#if defined(__x86_64__) || defined(__i386__)
+/* x86主机：时间戳计数器 */
+#include <x86intrin.h>
+#define UART_STATS_CYCLES() ((uint32_t)__rdtsc())
+#elif defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__) || defined(__ARM_ARCH_8M_MAIN__)
+/* Cortex-M3/M4/M7/M33：DWT->CYCCNT，使用前需置位DEMCR.TRCENA和DWT_CTRL.CYCCNTENA */
+#define UART_STATS_CYCLES() (*(volatile uint32_t *)0xE0001004)
+#elif defined(__TMS320C28XX__)
+/* C28x：CPU定时器2，预分频为1、周期为0xFFFFFFFF，递减计数，取反得到递增计数 */
+#define UART_STATS_CYCLES() (~CpuTimer2Regs.TIM.all)
+#else
+#error "UART_STATS requires UART_STATS_CYCLES()"
+#endif
+#endif
 
 /*--------------------此部分需要修改--------------------*/
 
+/**
+  * @brief  串口底层操作
+  */
+typedef struct
+{
+  void (*SendUint8)(void * hw, uint8_t UARTdata);   /*!<向发送寄存器写入一个字节 */
+  uint8_t (*TxReady)(void * hw);                    /*!<可以发送新数据时返回非0值 */
+  void (*TxIntEnable)(void * hw, uint8_t enable);   /*!<打开/关闭发送中断，不使用发送缓存时可为空 */
+  void (*SendBlock)(void * hw, const uint8_t * UARTdata, uint16_t num);
+                                                    /*!<一次发送一段数据（如DMA），可为空。
+                                                        UARTdata可能位于调用者的栈上，返回前必须已用完：
+                                                        DMA方式需等待传输完成，或先复制到底层自己的缓存 */
+} UARTPortOps;
+
+#ifdef UART_STATS
+/**
+  * @brief  UART_STATS统计的发送函数，原有UARTSend*函数计入对应的UARTPortSend*
+  */
+typedef enum
+{
+  UART_STATS_CHAR,
+  UART_STATS_BYTE,
+  UART_STATS_WORD,
+  UART_STATS_DWORD,
+  UART_STATS_UNSIGN_ASCII,
+  UART_STATS_SIGN_ASCII,
+  UART_STATS_FIXED,
+  UART_STATS_FLOAT,
+  UART_STATS_STRING,
+  UART_STATS_BYTE_ARRAY,
+  UART_STATS_WORD_ARRAY,
+  UART_STATS_DWORD_ARRAY,
+  UART_STATS_PRINTF,
+  UART_STATS_FUNC_NUM
+} UARTStatsFunc;
+
+/**
+  * @brief  单个发送函数的统计信息，单位为UART_STATS_CYCLES()的计数
+  *
+  * @detail
+  * 平均耗时为cycles / calls。函数内部调用其他发送函数时（如printf），只计入最外层函数。
+  * 耗时累计值达到UART_STATS_MAX后保持不变（饱和），不会回绕成较小的值；
+  * 此时平均值不再有效，需调用UARTPortStatsReset重新统计。
+  * 例如168MHz的Cortex-M上约25s的累计耗时即饱和，应按此估计读取统计信息的间隔。
+  */
+typedef struct
+{
+  uint32_t calls;       /*!<调用次数 */
+  uint32_t bytes;       /*!<发送（或写入发送缓存）的字节数 */
+  uint32_t cycles;      /*!<总耗时，饱和于UART_STATS_MAX */
+  uint32_t maxCycles;   /*!<单次调用最大耗时 */
+  uint32_t waitCycles;  /*!<等待发送寄存器或发送缓存的耗时，饱和于UART_STATS_MAX */
+} UARTFuncStats;
+
+/** 耗时累计值的上限，等于此值表示已饱和 */
+#define UART_STATS_MAX 0xFFFFFFFFUL
+
+/** 饱和累加，达到UART_STATS_MAX后不再增加，底层操作自行等待时也用于累计等待耗时 */
+#define UART_STATS_ADD(sum, n) ((sum) = (sum) > UART_STATS_MAX - (n) ? UART_STATS_MAX : (sum) + (n))
+#endif
+
+/**
+  * @brief  串口统计信息
+  */
+typedef struct
+{
+  uint32_t txBytes;   /*!<已发送（或已写入发送缓存）的字节数 */
+  uint32_t txWait;    /*!<因发送寄存器忙或发送缓存满而等待的次数 */
+#ifdef UART_STATS
+  uint32_t waitCycles;                      /*!<等待的总耗时，饱和于UART_STATS_MAX */
+  uint32_t callWait;                        /*!<最外层发送函数本次调用的等待耗时，内部使用 */
+  uint8_t depth;                            /*!<发送函数嵌套层数，内部使用 */
+  UARTFuncStats func[UART_STATS_FUNC_NUM];  /*!<各发送函数的统计信息 */
+#endif
+} UARTPortStats;
+
+/**
+  * @brief  串口对象
+  *
+  * @detail
+  * txBuffer为空时，发送函数直接等待发送寄存器可写后写入；
+  * 否则发送函数只写入发送缓存，由发送中断中调用的UARTPortTxISR写入发送寄存器。
+  * txBuffer为空且ops->SendBlock不为空时，UARTPortSend*Array整段交给SendBlock发送，
+  * 字/双字数组为栈上转换字节序后的暂存区，SendBlock返回后即失效。
+  */
+typedef struct UARTPort_t
+{
+  const UARTPortOps * ops;      /*!<底层操作 */
+  void * hw;                    /*!<底层操作使用的参数，一般为寄存器组地址 */
+  uint8_t * txBuffer;           /*!<发送缓存，大小为2的整数次幂，可为空 */
+  uint16_t txMask;              /*!<发送缓存大小 - 1 */
+  volatile uint16_t txHead;     /*!<发送缓存写入位置 */
+  volatile uint16_t txTail;     /*!<发送缓存读取位置，由发送中断更新 */
+  UARTPortStats stats;          /*!<统计信息 */
+} UARTPort;
+
+ErrorStatus UARTPortInit(UARTPort * port, const UARTPortOps * ops, void * hw,
+                         uint8_t * txBuffer, uint16_t txSize);
+
+void UARTPortTxISR(UARTPort * port);
+
+void UARTPortFlush(UARTPort * port);
+
+void UARTPortStatsReset(UARTPort * port);
+
+uint16_t UARTPortTxReserve(UARTPort * port, uint16_t num);
+
+void UARTPortTxCommit(UARTPort * port, uint16_t num);
+
+void UARTPortSendChar(UARTPort * port, const char c);
+
+void UARTPortSendByte(UARTPort * port, const uint8_t UARTdata);
+
+void UARTPortSendWord(UARTPort * port, const uint16_t UARTdata);
+
+void UARTPortSendDword(UARTPort * port, const uint32_t UARTdata);
+
+void UARTPortSendUnsignASCII(UARTPort * port, uint32_t UARTdata, uint8_t base, uint8_t align);
+
+void UARTPortSendSignASCII(UARTPort * port, int32_t UARTdata, uint8_t align);
+
+void UARTPortSendFixed(UARTPort * port, int32_t UARTdata, uint8_t frac, uint8_t prec);
+
+#ifndef UART_NO_FLOAT
+void UARTPortSendFloat(UARTPort * port, float UARTdata, uint8_t prec);
+#endif
+
+void UARTPortSendString(UARTPort * port, const char * str);
+
+void UARTPortSendByteArray(UARTPort * port, const uint8_t * UARTdata, const uint16_t num);
+
+void UARTPortSendWordArray(UARTPort * port, const uint16_t * UARTdata, const uint16_t num);
+
+void UARTPortSendDwordArray(UARTPort * port, const uint32_t * UARTdata, const uint16_t num);
+
+#ifndef UART_LEGACY
+void UARTPortPrintf(UARTPort * port, const char *format, ...);
+#endif
+
+#ifndef UART_NO_DEFAULT_PORT
+/** 默认串口，使用上面的HAL宏定义，不使用发送缓存 */
+extern UARTPort UARTDefaultPort;
+
 void UARTSendChar(const char c);
 
 void UARTSendByte(const uint8_t UARTdata);
@@ -85,6 +308,12 @@ void UARTSendUnsignASCII(uint32_t UARTdata, uint8_t base, uint8_t align);
 
 void UARTSendSignASCII(int32_t UARTdata, uint8_t align);
 
+void UARTSendFixed(int32_t UARTdata, uint8_t frac, uint8_t prec);
+
+#ifndef UART_NO_FLOAT
+void UARTSendFloat(float UARTdata, uint8_t prec);
+#endif
+
 void UARTSendString(const char * str);
 
 void UARTSendByteArray(const uint8_t * UARTdata, const uint16_t num);
@@ -96,6 +325,7 @@ void UARTSendDwordArray(const uint32_t * UARTdata, const uint16_t num);
 #ifndef UART_LEGACY
 void UARTprintf(const char *format, ...);
 #endif
+#endif
 
 /**
   * @}
@@ -0,0 +1,171 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+UARTDelta上位机解码工具
+
+将UARTDeltaSend/UARTDeltaEncode发送的差分压缩数据还原为采样值，每组输出一行，逗号分隔。
+
+用法：
+  uartdelta.py [-c 通道数] [--frame] [file]
+
+  -c       通道数，与设备端UARTDeltaInit的channels一致，默认为1
+  --frame  输入为SerialFrame帧（每帧一块），按0x00分帧，做COBS解码并校验CRC；
+           错误帧跳过，之后的数据等到下一个关键帧再输出
+  file     输入文件，省略时从标准输入读取
+
+解码统计（块数、错误帧数、组数、压缩比）输出到标准错误。
+
+修改记录：
+2026-10-18 :
+  - File Created.
+"""
+
+import sys
+
+
+def read_varint(data, pos):
+    """从data[pos]读取一个varint，返回(值, 新位置)，数据不完整时返回(None, pos)"""
+    value = 0
+    shift = 0
+    while pos < len(data):
+        b = data[pos]
+        pos += 1
+        value |= (b & 0x7F) << shift
+        if b < 0x80:
+            return value & 0xFFFFFFFF, pos
+        shift += 7
+    return None, pos
+
+
+def to_signed(v):
+    return v - (1 << 32) if v & 0x80000000 else v
+
+
+class Decoder(object):
+    def __init__(self, channels):
+        self.channels = channels
+        self.prev = [0] * channels
+        self.synced = False
+        self.blocks = 0
+        self.groups = 0
+        self.in_bytes = 0
+        self.errors = 0
+
+    def block(self, data, pos, out):
+        """解码从data[pos]开始的一块，返回新位置，数据不完整时返回None"""
+        start = pos
+        header, pos = read_varint(data, pos)
+        if header is None:
+            return None
+        num, key = header >> 1, header & 1
+        if key:
+            self.prev = [0] * self.channels
+            self.synced = True
+        rows = []
+        for _ in range(num):
+            row = []
+            for ch in range(self.channels):
+                z, pos = read_varint(data, pos)
+                if z is None:
+                    return None
+                # zigzag解码后按32位回绕相加
+                d = (z >> 1) ^ -(z & 1)
+                self.prev[ch] = (self.prev[ch] + d) & 0xFFFFFFFF
+                row.append(to_signed(self.prev[ch]))
+            rows.append(row)
+        self.blocks += 1
+        self.in_bytes += pos - start
+        if self.synced:
+            self.groups += num
+            for row in rows:
+                out.write(','.join(str(v) for v in row) + '\n')
+        return pos
+
+
+def crc32(data):
+    """与CRC模块CRC_Calculate相同：多项式0x04C11DB7，初值0xFFFFFFFF，高位在前，不取反"""
+    crc = 0xFFFFFFFF
+    for b in data:
+        crc ^= b << 24
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x04C11DB7 if crc & 0x80000000 else crc << 1) & 0xFFFFFFFF
+    return crc
+
+
+def cobs_decode(frame):
+    """COBS解码，格式错误时返回None"""
+    out = bytearray()
+    i = 0
+    while i < len(frame):
+        code = frame[i]
+        if code == 0 or i + code > len(frame):
+            return None
+        out += frame[i + 1:i + code]
+        i += code
+        if code < 0xFF and i < len(frame):
+            out.append(0)
+    return bytes(out)
+
+
+def decode_stream(dec, data, out):
+    pos = 0
+    while pos < len(data):
+        pos = dec.block(data, pos, out)
+        if pos is None:
+            break
+
+
+def decode_frames(dec, data, out):
+    for frame in data.split(b'\x00'):
+        if not frame:
+            continue
+        payload = cobs_decode(frame)
+        if payload is None or len(payload) < 4 or \
+                crc32(payload[:-4]) != int.from_bytes(payload[-4:], 'big'):
+            dec.errors += 1
+            dec.synced = False
+            continue
+        payload = payload[:-4]
+        if dec.block(payload, 0, out) != len(payload):
+            dec.errors += 1
+            dec.synced = False
+
+
+def main(argv):
+    channels = 1
+    frame = False
+    path = None
+    args = argv[1:]
+    while args:
+        a = args.pop(0)
+        if a == '-c' and args:
+            channels = int(args.pop(0))
+        elif a == '--frame':
+            frame = True
+        elif a.startswith('-'):
+            sys.stderr.write(__doc__)
+            return 2
+        else:
+            path = a
+
+    if path is None:
+        data = sys.stdin.buffer.read()
+    else:
+        with open(path, 'rb') as f:
+            data = f.read()
+
+    dec = Decoder(channels)
+    if frame:
+        decode_frames(dec, data, sys.stdout)
+    else:
+        decode_stream(dec, data, sys.stdout)
+
+    raw = dec.groups * channels * 4
+    sys.stderr.write('%d blocks, %d errors, %d groups, %d bytes -> %d bytes as Dword, ratio %.2f\n'
+                     % (dec.blocks, dec.errors, dec.groups, dec.in_bytes, raw,
+                        raw / dec.in_bytes if dec.in_bytes else 0))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv))
@@ -0,0 +1,134 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+UARTLog上位机解码工具
+
+根据设备端使用的消息定义文件(UARTLogMsg.def)，将UARTLog发送的二进制日志还原为文本。
+
+用法：
+  uartlog.py ids    UARTLogMsg.def            列出消息编号，并检查参数个数与格式化字符串是否一致
+  uartlog.py decode UARTLogMsg.def [file]     解码日志，file省略时从标准输入读取
+
+修改记录：
+2026-10-18 :
+  - File Created.
+"""
+
+import re
+import sys
+
+MSG_RE = re.compile(r'^\s*UART_LOG_MSG\s*\(\s*(\w+)\s*,\s*(\d+)\s*,\s*"((?:[^"\\]|\\.)*)"\s*\)')
+SPEC_RE = re.compile(r'%(.)')
+
+
+def unescape(s):
+    """处理C字符串中的转义字符，非ASCII字符（如中文）保持不变"""
+    return s.encode('latin-1', 'backslashreplace').decode('unicode_escape')
+
+
+def load_defs(path):
+    """读取消息定义文件，返回[(名称, 参数个数, 格式化字符串)]，下标即为编号"""
+    msgs = []
+    with open(path, encoding='utf-8') as f:
+        for line in f:
+            m = MSG_RE.match(line)
+            if m:
+                msgs.append((m.group(1), int(m.group(2)), unescape(m.group(3))))
+    return msgs
+
+
+def spec_count(fmt):
+    return sum(1 for c in SPEC_RE.findall(fmt) if c in 'duxbc')
+
+
+def read_varint(stream):
+    """读取一个varint，数据结束时返回None"""
+    value = 0
+    shift = 0
+    while True:
+        b = stream.read(1)
+        if not b:
+            return None
+        b = b[0]
+        value |= (b & 0x7F) << shift
+        if b < 0x80:
+            return value & 0xFFFFFFFF
+        shift += 7
+
+
+def format_msg(fmt, args):
+    """与设备端UARTprintf相同的格式化规则"""
+    out = []
+    it = iter(args)
+    i = 0
+    while i < len(fmt):
+        c = fmt[i]
+        if c != '%' or i + 1 >= len(fmt):
+            out.append(c)
+            i += 1
+            continue
+        spec = fmt[i + 1]
+        i += 2
+        if spec == 'd':
+            v = next(it)
+            out.append('%+d' % (v - (1 << 32) if v & 0x80000000 else v))
+        elif spec == 'u':
+            out.append('%u' % next(it))
+        elif spec == 'x':
+            v = next(it)
+            out.append('%0*X' % (2 if v <= 0xFF else 4 if v <= 0xFFFF else 8, v))
+        elif spec == 'b':
+            v = next(it)
+            out.append(format(v, '0%db' % (8 if v <= 0xFF else 16 if v <= 0xFFFF else 32)))
+        elif spec == 'c':
+            out.append(chr(next(it) & 0xFF))
+        else:
+            out.append('%' + spec)
+    return ''.join(out)
+
+
+def cmd_ids(msgs):
+    ok = True
+    for i, (name, argc, fmt) in enumerate(msgs):
+        n = spec_count(fmt)
+        flag = '' if n == argc else '  <-- 参数个数与格式化字符串不符(%d)' % n
+        ok = ok and n == argc
+        print('%5d  %-24s %d  %r%s' % (i, name, argc, fmt, flag))
+    return 0 if ok else 1
+
+
+def cmd_decode(msgs, stream):
+    out = sys.stdout
+    while True:
+        msg_id = read_varint(stream)
+        if msg_id is None:
+            return 0
+        if msg_id >= len(msgs):
+            out.write('<unknown id %d>\n' % msg_id)
+            continue
+        name, argc, fmt = msgs[msg_id]
+        args = []
+        for _ in range(argc):
+            v = read_varint(stream)
+            if v is None:
+                return 0
+            args.append(v)
+        out.write(format_msg(fmt, args))
+        out.flush()
+
+
+def main(argv):
+    if len(argv) < 3 or argv[1] not in ('ids', 'decode'):
+        sys.stderr.write(__doc__)
+        return 2
+    msgs = load_defs(argv[2])
+    if argv[1] == 'ids':
+        return cmd_ids(msgs)
+    if len(argv) > 3:
+        with open(argv[3], 'rb') as f:
+            return cmd_decode(msgs, f)
+    return cmd_decode(msgs, sys.stdin.buffer)
+
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv))
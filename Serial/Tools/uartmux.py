@@ -0,0 +1,104 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+UARTMux上位机分离工具
+
+将UARTMux多路复用后的串口数据按通道分离。
+
+用法：
+  uartmux.py [-o 前缀] [file]        各通道数据分别写入"前缀<通道号>.bin"，默认前缀为"ch"
+  uartmux.py -c 通道号 [file]        只将指定通道的数据输出到标准输出，可接其他工具，如：
+                                     uartmux.py -c 1 dump.bin | uartlog.py decode UARTLogMsg.def
+
+  file省略时从标准输入读取。各通道的字节数（去掉通道头和转义后）输出到标准错误。
+
+数据格式见UARTMux.h：[0xC0][通道号]为通道头，0xDB 0xDC为0xC0，0xDB 0xDD为0xDB。
+
+修改记录：
+2026-10-18 :
+  - File Created.
+"""
+
+import sys
+
+SYNC = 0xC0
+ESC = 0xDB
+ESC_SYNC = 0xDC
+ESC_ESC = 0xDD
+
+
+class Demux(object):
+    def __init__(self):
+        self.channel = None     # 当前通道，None表示尚未收到通道头
+        self.state = 0          # 0：数据，1：等待通道号，2：转义
+        self.errors = 0
+        self.data = {}
+
+    def feed(self, chunk):
+        for b in chunk:
+            if b == SYNC:
+                self.state = 1
+                continue
+            if self.state == 1:
+                self.channel = b
+                self.data.setdefault(b, bytearray())
+                self.state = 0
+                continue
+            if self.state == 2:
+                self.state = 0
+                if b == ESC_SYNC:
+                    b = SYNC
+                elif b == ESC_ESC:
+                    b = ESC
+                else:
+                    self.errors += 1
+                    continue
+            elif b == ESC:
+                self.state = 2
+                continue
+            if self.channel is not None:
+                self.data[self.channel].append(b)
+
+
+def main(argv):
+    prefix = 'ch'
+    only = None
+    path = None
+    args = argv[1:]
+    while args:
+        a = args.pop(0)
+        if a == '-o' and args:
+            prefix = args.pop(0)
+        elif a == '-c' and args:
+            only = int(args.pop(0))
+        elif a.startswith('-'):
+            sys.stderr.write(__doc__)
+            return 2
+        else:
+            path = a
+
+    if path is None:
+        raw = sys.stdin.buffer.read()
+    else:
+        with open(path, 'rb') as f:
+            raw = f.read()
+
+    demux = Demux()
+    demux.feed(raw)
+
+    for ch in sorted(demux.data):
+        sys.stderr.write('channel %d: %d bytes\n' % (ch, len(demux.data[ch])))
+    if demux.errors:
+        sys.stderr.write('%d escape errors\n' % demux.errors)
+
+    if only is not None:
+        sys.stdout.buffer.write(bytes(demux.data.get(only, b'')))
+    else:
+        for ch, data in demux.data.items():
+            with open('%s%d.bin' % (prefix, ch), 'wb') as f:
+                f.write(data)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv))
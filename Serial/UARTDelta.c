@@ -0,0 +1,186 @@
+/**
+  **************************************************************
+  * @file       UARTDelta.c
+  * @author	    高明飞
+  * @version    V0.1
+  * @date       2026-10-18
+  *
+  * @brief      采样数据流的差分 + varint压缩
+  *
+  * @details
+  * @verbatim
+  * 每个数据只需一次减法、一次移位异或和1~5次字节存储，不使用乘除法。
+  *
+  * 修改记录：
+  * 2026-10-18 :
+  *   - File Created.
+  * @endverbatim
+  ***************************************************************
+  */
+
+/** @addtogroup Serial
+  * @{
+  */
+
+/** @addtogroup UARTDelta
+  * @{
+  */
+
+#include "UARTDelta.h"
+
+/* 内部使用的函数声明 */
+static uint16_t _UARTDeltaHeader(UARTDeltaEncoder * enc, uint16_t num, uint8_t * out);
+static uint8_t _UARTDeltaPut(UARTDeltaEncoder * enc, uint8_t ch, int32_t sample, uint8_t * out);
+
+/**
+  * @brief  初始化编码器
+  *
+  * @param  enc:         编码器指针
+  * @param  channels:    通道数，1~UART_DELTA_MAX_CHANNELS
+  * @param  keyInterval: 关键帧间隔（块数），0表示只在复位后发送关键帧
+  *
+  * @retval SUCCESS 执行成功
+  * @retval ERROR   通道数错误
+  */
+ErrorStatus UARTDeltaInit(UARTDeltaEncoder * enc, uint8_t channels, uint16_t keyInterval)
+{
+  if(channels == 0 || channels > UART_DELTA_MAX_CHANNELS)
+    return ERROR;
+
+  enc->channels = channels;
+  enc->keyInterval = keyInterval;
+  UARTDeltaReset(enc);
+
+  return SUCCESS;
+}
+
+/**
+  * @brief  复位编码器，下一块为关键帧
+  *
+  * @param  enc: 编码器指针
+  *
+  * @retval None
+  *
+  * @note   接收端重新连接或检测到数据错误时调用
+  */
+void UARTDeltaReset(UARTDeltaEncoder * enc)
+{
+  enc->key = 1;
+  enc->blocks = 0;
+}
+
+/**
+  * @brief  将一块数据编码到缓存中
+  *
+  * @param  enc:     编码器指针
+  * @param  samples: 数据，按组排列，每组channels个数据
+  * @param  num:     组数
+  * @param  out:     编码结果存放位置，大小至少为UART_DELTA_ENCODED_SIZE(num * channels)
+  *
+  * @retval 编码后的长度
+  */
+uint16_t UARTDeltaEncode(UARTDeltaEncoder * enc, const int32_t * samples, uint16_t num, uint8_t * out)
+{
+  uint16_t n, i;
+  uint8_t ch;
+
+  n = _UARTDeltaHeader(enc, num, out);
+  for(i = 0; i < num; i++)
+    for(ch = 0; ch < enc->channels; ch++)
+      n += _UARTDeltaPut(enc, ch, *samples++, out + n);
+
+  return n;
+}
+
+/**
+  * @brief  编码并发送一块数据
+  *
+  * @param  enc:     编码器指针
+  * @param  port:    串口对象指针
+  * @param  samples: 数据，按组排列，每组channels个数据
+  * @param  num:     组数
+  *
+  * @retval void
+  *
+  * @note
+  * 编码到栈上的缓存中，缓存将满时整段发送，不需要整块数据大小的缓存。
+  */
+void UARTDeltaSend(UARTDeltaEncoder * enc, UARTPort * port, const int32_t * samples, uint16_t num)
+{
+  uint8_t buf[UART_DELTA_BUFFER_SIZE];
+  uint16_t n, i;
+  uint8_t ch;
+
+  n = _UARTDeltaHeader(enc, num, buf);
+  for(i = 0; i < num; i++)
+  {
+    for(ch = 0; ch < enc->channels; ch++)
+    {
+      /* 剩余空间不足一个数据的最大长度时先发送 */
+      if(n > UART_DELTA_BUFFER_SIZE - UART_VARINT_MAX)
+      {
+        UARTPortSendByteArray(port, buf, n);
+        n = 0;
+      }
+      n += _UARTDeltaPut(enc, ch, *samples++, buf + n);
+    }
+  }
+
+  if(n != 0)
+    UARTPortSendByteArray(port, buf, n);
+}
+
+/**
+  * @brief  写入块头，决定本块是否为关键帧
+  */
+static uint16_t _UARTDeltaHeader(UARTDeltaEncoder * enc, uint16_t num, uint8_t * out)
+{
+  uint8_t ch, key;
+
+  if(enc->keyInterval != 0 && enc->blocks >= enc->keyInterval)
+    enc->key = 1;
+
+  if(enc->key)
+  {
+    /* 关键帧：与0做差，即发送原始值 */
+    for(ch = 0; ch < enc->channels; ch++)
+      enc->prev[ch] = 0;
+    enc->blocks = 0;
+  }
+  enc->blocks++;
+
+  key = enc->key;
+  enc->key = 0;
+
+  return UARTVarintEncode(((uint32_t)num << 1) | key, out);
+}
+
+/**
+  * @brief  编码一个数据，返回编码后的字节数
+  */
+static uint8_t _UARTDeltaPut(UARTDeltaEncoder * enc, uint8_t ch, int32_t sample, uint8_t * out)
+{
+  uint32_t d;
+
+  /* 无符号运算，溢出时按32位回绕，解码端同样回绕 */
+  d = (uint32_t)sample - enc->prev[ch];
+  enc->prev[ch] = (uint32_t)sample;
+
+  d = UART_ZIGZAG32(d);
+
+  /* 大多数差值只需1字节 */
+  if(d < 0x80)
+  {
+    out[0] = (uint8_t)d;
+    return 1;
+  }
+  return UARTVarintEncode(d, out);
+}
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
@@ -0,0 +1,108 @@
+/**
+  **************************************************************
+  * @file       UARTDelta.h
+  * @author	    高明飞
+  * @version    V0.1
+  * @date       2026-10-18
+  *
+  * @brief      采样数据流的差分 + varint压缩
+  *
+  * @details
+  * @verbatim
+  * 用UARTSendDwordArray发送ADC、编码器等缓慢变化的数据时，每个数据固定占4字节，
+  * 而相邻数据通常只差几个数。本模块只发送与上一个数据的差值：
+  *   差值 = 本次数据 - 同一通道的上一个数据（按32位回绕）
+  *   zigzag = (差值 << 1) ^ (差值 >> 31)    将有符号数映射为无符号数，小的负数也很小
+  *   varint(zigzag)                         LEB128编码，见UARTVarint.h
+  * 差值在-64~63之间时只占1字节，-8192~8191之间时占2字节。
+  *
+  * 数据按块发送，每块的格式为：
+  *   [varint(组数 * 2 + 关键帧标志)][数据1]...[数据n]
+  * 每组包含channels个通道的数据，按通道顺序排列。
+  * 关键帧中的数据为原始值（相当于与0的差值），解码端从关键帧开始即可正确解码。
+  * 初始化或调用UARTDeltaReset后的第一块为关键帧，另外可每隔keyInterval块插入一个关键帧。
+  *
+  * 数据流本身不带同步信息，通信可能出错时，可用UARTDeltaEncode编码后
+  * 再用SerialFrameSend按帧发送，每帧一块。
+  *
+  * 上位机使用Tools/uartdelta.py解码，通道数需与设备端一致。
+  *
+  * 修改记录：
+  * 2026-10-18 :
+  *   - File Created.
+  *   - 改为包含UARTVarint.h，不再依赖UARTLog.h及消息定义文件
+  * @endverbatim
+  ***************************************************************
+  */
+
+#ifndef UARTDELTA_H
+#define UARTDELTA_H
+
+/* C++ */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "Serial_BSP.h"
+#include "UARTVarint.h"
+
+/** @addtogroup Serial
+  * @{
+  */
+
+/** @addtogroup UARTDelta
+  * @brief      采样数据流的差分 + varint压缩
+  * @{
+  */
+
+/*--------------------此部分需要修改--------------------*/
+/**
+  * 最多通道数
+  */
+#define UART_DELTA_MAX_CHANNELS 4
+
+/**
+  * UARTDeltaSend使用的栈上编码缓存大小，不小于10
+  */
+#define UART_DELTA_BUFFER_SIZE 64
+/*--------------------此部分需要修改--------------------*/
+
+/**
+  * 编码num个数据（组数 * 通道数）后的最大长度
+  */
+#define UART_DELTA_ENCODED_SIZE(num) (UART_VARINT_MAX + UART_VARINT_MAX * (num))
+
+/**
+  * @brief  编码器
+  */
+typedef struct
+{
+  uint32_t prev[UART_DELTA_MAX_CHANNELS];   /*!<各通道的上一个数据 */
+  uint8_t channels;                         /*!<通道数 */
+  uint8_t key;                              /*!<下一块为关键帧 */
+  uint16_t keyInterval;                     /*!<关键帧间隔（块数），0表示只在复位后发送关键帧 */
+  uint16_t blocks;                          /*!<距上一个关键帧的块数 */
+} UARTDeltaEncoder;
+
+ErrorStatus UARTDeltaInit(UARTDeltaEncoder * enc, uint8_t channels, uint16_t keyInterval);
+
+void UARTDeltaReset(UARTDeltaEncoder * enc);
+
+uint16_t UARTDeltaEncode(UARTDeltaEncoder * enc, const int32_t * samples, uint16_t num, uint8_t * out);
+
+void UARTDeltaSend(UARTDeltaEncoder * enc, UARTPort * port, const int32_t * samples, uint16_t num);
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/* C++ */
+#ifdef __cplusplus
+}
+#endif
+
+#endif
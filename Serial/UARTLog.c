@@ -0,0 +1,101 @@
+/**
+  **************************************************************
+  * @file       UARTLog.c
+  * @author	    高明飞
+  * @version    V0.1
+  * @date       2026-10-18
+  *
+  * @brief      延迟格式化的二进制日志
+  *
+  * @details
+  * @verbatim
+  * 设备端不发送格式化字符串，只发送字符串编号和原始参数，
+  * 由上位机工具Tools/uartlog.py根据同一份消息定义文件还原文本。
+  *
+  * 修改记录：
+  * 2026-10-18 :
+  *   - File Created.
+  *   - 发送函数增加串口对象参数
+  * @endverbatim
+  ***************************************************************
+  */
+
+/** @addtogroup Serial
+  * @{
+  */
+
+/** @addtogroup UARTLog
+  * @{
+  */
+
+#include "UARTLog.h"
+
+#ifndef UART_LEGACY
+#include "stdarg.h"
+#endif
+
+/**
+  * @brief  发送一条日志，参数以数组形式给出
+  *
+  * @param  port: 串口对象指针
+  * @param  id:   消息编号，UART_LOG_ID_名称
+  * @param  argc: 参数个数，不大于UART_LOG_MAX_ARGS
+  * @param  argv: 参数数组，argc为0时可为空指针
+  *
+  * @retval void
+  *
+  * @note   整条日志先编码到栈上的缓存中，再一次性发送
+  */
+void UARTLogSend(UARTPort * port, uint16_t id, uint8_t argc, const uint32_t * argv)
+{
+  uint8_t buf[3 + UART_VARINT_MAX * UART_LOG_MAX_ARGS];
+  uint8_t n, i;
+
+  if(argc > UART_LOG_MAX_ARGS)
+    argc = UART_LOG_MAX_ARGS;
+
+  n = UARTVarintEncode(id, buf);
+  for(i = 0; i < argc; i++)
+    n += UARTVarintEncode(argv[i], buf + n);
+
+  UARTPortSendByteArray(port, buf, n);
+}
+
+#ifndef UART_LEGACY
+/**
+  * @brief  发送一条日志，参数以可变参数形式给出
+  *
+  * @param  port: 串口对象指针
+  * @param  id:   消息编号，UART_LOG_ID_名称
+  * @param  argc: 参数个数，不大于UART_LOG_MAX_ARGS
+  *
+  * @retval void
+  *
+  * @warning
+  * 可变参数的类型必须为uint32_t，建议通过UART_LOGn宏调用，宏中已做类型转换
+  */
+void UARTLog(UARTPort * port, uint16_t id, int argc, ...)
+{
+  va_list ap;
+  uint32_t argv[UART_LOG_MAX_ARGS];
+  int i;
+
+  if(argc > UART_LOG_MAX_ARGS)
+    argc = UART_LOG_MAX_ARGS;
+
+  va_start(ap, argc);
+  for(i = 0; i < argc; i++)
+    argv[i] = va_arg(ap, uint32_t);
+  va_end(ap);
+
+  UARTLogSend(port, id, (uint8_t)argc, argv);
+}
+#endif
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
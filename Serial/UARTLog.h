@@ -0,0 +1,150 @@
+/**
+  **************************************************************
+  * @file       UARTLog.h
+  * @author	    高明飞
+  * @version    V0.1
+  * @date       2026-10-18
+  *
+  * @brief      延迟格式化的二进制日志
+  *
+  * @details
+  * @verbatim
+  * 设备端不发送格式化字符串，只发送字符串编号和原始参数，
+  * 由上位机工具Tools/uartlog.py根据同一份消息定义文件还原文本。
+  *
+  * 消息定义文件（默认为UARTLogMsg.def）中每行一条消息：
+  *   UART_LOG_MSG(名称, 参数个数, "格式化字符串")
+  * 编号按定义顺序从0开始分配，增删消息后需同时更新上位机使用的定义文件。
+  *
+  * 每条日志的格式为：
+  *   [编号 varint][参数1 varint]...[参数n varint]
+  * varint为LEB128编码，每字节低7位为数据，最高位为1表示后面还有字节。
+  *
+  * 使用方法：
+  *   UART_LOG2(ADC_SAMPLE, adc, temp);
+  *
+  * 修改记录：
+  * 2026-10-18 :
+  *   - File Created.
+  *   - 发送函数增加串口对象参数
+  *   - UARTVarintEncode移至UARTVarint.h，需同时编译UARTVarint.c
+  * @endverbatim
+  *
+  * @note
+  * 格式化字符串支持的占位符与UARTprintf相同（%s除外），参数均按uint32_t发送。
+  * 日志数据本身不带同步信息，丢失字节后需等待上位机重新同步。
+  ***************************************************************
+  */
+
+#ifndef UARTLOG_H
+#define UARTLOG_H
+
+/* C++ */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "Serial_BSP.h"
+#include "UARTVarint.h"
+
+/** @addtogroup Serial
+  * @{
+  */
+
+/** @addtogroup UARTLog
+  * @brief      延迟格式化的二进制日志
+  * @{
+  */
+
+/*--------------------此部分需要修改--------------------*/
+/**
+  * 消息定义文件
+  */
+#ifndef UART_LOG_DEF_FILE
+#define UART_LOG_DEF_FILE "UARTLogMsg.def"
+#endif
+
+/**
+  * 每条日志最多的参数个数，UART_LOG0~UART_LOG6宏最多支持6个
+  */
+#define UART_LOG_MAX_ARGS 6
+
+/**
+  * UART_LOGn宏使用的串口
+  */
+#ifndef UART_LOG_PORT
+#define UART_LOG_PORT (&UARTDefaultPort)
+#endif
+/*--------------------此部分需要修改--------------------*/
+
+/** 消息编号，UART_LOG_ID_名称 */
+enum
+{
+#define UART_LOG_MSG(name, argc, fmt) UART_LOG_ID_##name,
+#include UART_LOG_DEF_FILE
+#undef UART_LOG_MSG
+  UART_LOG_ID_COUNT
+};
+
+/** 消息参数个数，UART_LOG_ARGC_名称 */
+enum
+{
+#define UART_LOG_MSG(name, argc, fmt) UART_LOG_ARGC_##name = argc,
+#include UART_LOG_DEF_FILE
+#undef UART_LOG_MSG
+  UART_LOG_ARGC_DUMMY
+};
+
+/**
+  * 编译期检查参数个数与定义是否一致，不一致时数组大小为负，编译报错
+  */
+#define UART_LOG_CHECK_ARGC(name, n) \
+  ((void)sizeof(char[(UART_LOG_ARGC_##name == (n)) ? 1 : -1]))
+
+/**
+  * 发送日志，n为参数个数
+  */
+#define UART_LOG0(name) \
+  (UART_LOG_CHECK_ARGC(name, 0), UARTLogSend(UART_LOG_PORT, UART_LOG_ID_##name, 0, 0))
+
+#ifndef UART_LEGACY
+#define UART_LOG1(name, a) \
+  (UART_LOG_CHECK_ARGC(name, 1), UARTLog(UART_LOG_PORT, UART_LOG_ID_##name, 1, \
+    (uint32_t)(a)))
+#define UART_LOG2(name, a, b) \
+  (UART_LOG_CHECK_ARGC(name, 2), UARTLog(UART_LOG_PORT, UART_LOG_ID_##name, 2, \
+    (uint32_t)(a), (uint32_t)(b)))
+#define UART_LOG3(name, a, b, c) \
+  (UART_LOG_CHECK_ARGC(name, 3), UARTLog(UART_LOG_PORT, UART_LOG_ID_##name, 3, \
+    (uint32_t)(a), (uint32_t)(b), (uint32_t)(c)))
+#define UART_LOG4(name, a, b, c, d) \
+  (UART_LOG_CHECK_ARGC(name, 4), UARTLog(UART_LOG_PORT, UART_LOG_ID_##name, 4, \
+    (uint32_t)(a), (uint32_t)(b), (uint32_t)(c), (uint32_t)(d)))
+#define UART_LOG5(name, a, b, c, d, e) \
+  (UART_LOG_CHECK_ARGC(name, 5), UARTLog(UART_LOG_PORT, UART_LOG_ID_##name, 5, \
+    (uint32_t)(a), (uint32_t)(b), (uint32_t)(c), (uint32_t)(d), (uint32_t)(e)))
+#define UART_LOG6(name, a, b, c, d, e, f) \
+  (UART_LOG_CHECK_ARGC(name, 6), UARTLog(UART_LOG_PORT, UART_LOG_ID_##name, 6, \
+    (uint32_t)(a), (uint32_t)(b), (uint32_t)(c), (uint32_t)(d), (uint32_t)(e), (uint32_t)(f)))
+#endif
+
+void UARTLogSend(UARTPort * port, uint16_t id, uint8_t argc, const uint32_t * argv);
+
+#ifndef UART_LEGACY
+void UARTLog(UARTPort * port, uint16_t id, int argc, ...);
+#endif
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/* C++ */
+#ifdef __cplusplus
+}
+#endif
+
+#endif
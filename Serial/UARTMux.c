@@ -0,0 +1,313 @@
+/**
+  **************************************************************
+  * @file       UARTMux.c
+  * @author	    高明飞
+  * @version    V0.1
+  * @date       2026-10-18
+  *
+  * @brief      单个串口上的多路虚拟通道
+  *
+  * @details
+  * @verbatim
+  * 各通道的UARTPort不使用发送缓存，其底层操作将数据写入通道队列并打开物理串口的发送中断；
+  * 发送中断中由UARTMuxTxISR调度各通道队列。
+  *
+  * 修改记录：
+  * 2026-10-18 :
+  *   - File Created.
+  *   - 整段发送时队列满的等待也计入txWait及UART_STATS的等待耗时
+  * @endverbatim
+  ***************************************************************
+  */
+
+/** @addtogroup Serial
+  * @{
+  */
+
+/** @addtogroup UARTMux
+  * @{
+  */
+
+#include "UARTMux.h"
+
+#include "string.h"
+
+/* 内部使用的函数声明 */
+static Bool _UARTMuxNextByte(UARTMux * mux, uint8_t * c);
+static UARTMuxChannel * _UARTMuxSelect(UARTMux * mux);
+static void _UARTMuxSend(void * hw, uint8_t UARTdata);
+static uint8_t _UARTMuxTxReady(void * hw);
+static void _UARTMuxSendBlock(void * hw, const uint8_t * UARTdata, uint16_t num);
+static void _UARTMuxWait(UARTMuxChannel * ch, uint16_t head);
+
+/* 通道串口的底层操作，hw为UARTMuxChannel指针 */
+static const UARTPortOps _UARTMuxOps =
+{
+  _UARTMuxSend, _UARTMuxTxReady, 0, _UARTMuxSendBlock
+};
+
+/**
+  * @brief  初始化多路复用对象
+  *
+  * @param  mux: 多路复用对象指针
+  * @param  ops: 物理串口的底层操作，TxIntEnable不能为空
+  * @param  hw:  物理串口底层操作使用的参数
+  *
+  * @retval SUCCESS 执行成功
+  * @retval ERROR   参数错误
+  */
+ErrorStatus UARTMuxInit(UARTMux * mux, const UARTPortOps * ops, void * hw)
+{
+  uint8_t i;
+
+  if(ops->TxIntEnable == 0)
+    return ERROR;
+
+  mux->ops = ops;
+  mux->hw = hw;
+  for(i = 0; i < UART_MUX_MAX_CHANNELS; i++)
+    mux->ch[i] = 0;
+  mux->cur = 0;
+  mux->wire = 0xFF;
+  mux->pendNum = 0;
+
+  return SUCCESS;
+}
+
+/**
+  * @brief  初始化一个虚拟通道及其串口对象
+  *
+  * @param  mux:      多路复用对象指针
+  * @param  ch:       通道对象指针
+  * @param  port:     通道的串口对象指针，初始化后用UARTPortSend*系列函数发送
+  * @param  id:       通道号，0~UART_MUX_MAX_CHANNELS-1
+  * @param  buffer:   发送队列
+  * @param  size:     发送队列大小，必须为2的整数次幂，且不大于32768
+  * @param  quantum:  每轮最多发送的字节数，各普通通道的带宽按此比例分配
+  * @param  priority: 不为0时为优先通道，有数据时总是先发送
+  *
+  * @retval SUCCESS 执行成功
+  * @retval ERROR   参数错误
+  */
+ErrorStatus UARTMuxChannelInit(UARTMux * mux, UARTMuxChannel * ch, UARTPort * port, uint8_t id,
+                               uint8_t * buffer, uint16_t size, uint16_t quantum, uint8_t priority)
+{
+  if(id >= UART_MUX_MAX_CHANNELS || size < 2 || size > 32768 || (size & (size - 1)) != 0
+     || quantum == 0 || quantum > 0x4000)
+    return ERROR;
+
+  ch->mux = mux;
+  ch->port = port;
+  ch->buffer = buffer;
+  ch->mask = size - 1;
+  ch->head = 0;
+  ch->tail = 0;
+  ch->quantum = quantum;
+  ch->deficit = 0;
+  ch->id = id;
+  ch->priority = priority;
+  ch->wireBytes = 0;
+  mux->ch[id] = ch;
+
+  return UARTPortInit(port, &_UARTMuxOps, ch, 0, 0);
+}
+
+/**
+  * @brief  物理串口的发送中断中调用，按调度规则发送各通道的数据
+  *
+  * @param  mux: 多路复用对象指针
+  *
+  * @retval None
+  *
+  * @note   所有通道均无数据时关闭发送中断
+  */
+void UARTMuxTxISR(UARTMux * mux)
+{
+  uint8_t c;
+
+  while(mux->ops->TxReady(mux->hw))
+  {
+    if(!_UARTMuxNextByte(mux, &c))
+    {
+      mux->ops->TxIntEnable(mux->hw, 0);
+      return;
+    }
+    mux->ops->SendUint8(mux->hw, c);
+  }
+}
+
+/**
+  * @brief  取得下一个要发送的字节，没有数据时返回FALSE
+  */
+static Bool _UARTMuxNextByte(UARTMux * mux, uint8_t * c)
+{
+  UARTMuxChannel * ch;
+  uint8_t data;
+
+  /* 先发送未发完的通道头或转义字节 */
+  if(mux->pendNum != 0)
+  {
+    *c = mux->pend[0];
+    mux->pend[0] = mux->pend[1];
+    mux->pendNum--;
+    return TRUE;
+  }
+
+  ch = _UARTMuxSelect(mux);
+  if(ch == 0)
+    return FALSE;
+
+  /* 通道改变时先发送通道头 */
+  if(mux->wire != ch->id)
+  {
+    mux->wire = ch->id;
+    mux->pend[0] = ch->id;
+    mux->pendNum = 1;
+    ch->deficit -= 2;
+    ch->wireBytes += 2;
+    *c = UART_MUX_SYNC;
+    return TRUE;
+  }
+
+  data = ch->buffer[ch->tail & ch->mask];
+  ch->tail++;
+
+  if(data == UART_MUX_SYNC || data == UART_MUX_ESC)
+  {
+    mux->pend[0] = data == UART_MUX_SYNC ? UART_MUX_ESC_SYNC : UART_MUX_ESC_ESC;
+    mux->pendNum = 1;
+    ch->deficit -= 2;
+    ch->wireBytes += 2;
+    *c = UART_MUX_ESC;
+  }
+  else
+  {
+    ch->deficit--;
+    ch->wireBytes++;
+    *c = data;
+  }
+
+  return TRUE;
+}
+
+/**
+  * @brief  选择下一个发送数据的通道，所有通道均无数据时返回空指针
+  *
+  * @note
+  * 优先通道按通道号顺序优先；普通通道按差额轮询：轮到某通道时增加quantum的额度，
+  * 额度用完或队列为空时轮到下一个通道，队列为空的通道额度清零。
+  */
+static UARTMuxChannel * _UARTMuxSelect(UARTMux * mux)
+{
+  UARTMuxChannel * ch;
+  uint8_t i, id;
+
+  for(i = 0; i < UART_MUX_MAX_CHANNELS; i++)
+  {
+    ch = mux->ch[i];
+    if(ch != 0 && ch->priority && ch->head != ch->tail)
+      return ch;
+  }
+
+  /* 当前通道还有额度和数据时继续发送 */
+  ch = mux->ch[mux->cur];
+  if(ch != 0 && !ch->priority && ch->deficit > 0 && ch->head != ch->tail)
+    return ch;
+  if(ch != 0 && ch->head == ch->tail)
+    ch->deficit = 0;
+
+  /* 轮到下一个有数据的普通通道，最多检查一圈（当前通道在最后） */
+  id = mux->cur;
+  for(i = 0; i < UART_MUX_MAX_CHANNELS; i++)
+  {
+    id = id + 1 < UART_MUX_MAX_CHANNELS ? id + 1 : 0;
+    ch = mux->ch[id];
+    if(ch == 0 || ch->priority)
+      continue;
+    if(ch->head == ch->tail)
+    {
+      ch->deficit = 0;
+      continue;
+    }
+    mux->cur = id;
+    ch->deficit += ch->quantum;
+    return ch;
+  }
+
+  return 0;
+}
+
+/* 通道串口的底层操作 */
+static void _UARTMuxSend(void * hw, uint8_t UARTdata)
+{
+  UARTMuxChannel * ch = (UARTMuxChannel *)hw;
+  uint16_t head = ch->head;
+
+  ch->buffer[head & ch->mask] = UARTdata;
+  ch->head = head + 1;
+  ch->mux->ops->TxIntEnable(ch->mux->hw, 1);
+}
+
+static uint8_t _UARTMuxTxReady(void * hw)
+{
+  UARTMuxChannel * ch = (UARTMuxChannel *)hw;
+
+  return (uint16_t)(ch->head - ch->tail) <= ch->mask;
+}
+
+static void _UARTMuxSendBlock(void * hw, const uint8_t * UARTdata, uint16_t num)
+{
+  UARTMuxChannel * ch = (UARTMuxChannel *)hw;
+  uint16_t head, space, n;
+
+  while(num != 0)
+  {
+    /* 等待队列有空闲 */
+    head = ch->head;
+    if((uint16_t)(head - ch->tail) > ch->mask)
+      _UARTMuxWait(ch, head);
+    space = ch->mask + 1 - (uint16_t)(head - ch->tail);
+
+    /* 不超过队列末尾及空闲空间 */
+    n = ch->mask + 1 - (head & ch->mask);
+    if(n > space)
+      n = space;
+    if(n > num)
+      n = num;
+
+    memcpy(ch->buffer + (head & ch->mask), UARTdata, n);
+    ch->head = head + n;
+    ch->mux->ops->TxIntEnable(ch->mux->hw, 1);
+
+    UARTdata += n;
+    num -= n;
+  }
+}
+
+/**
+  * @brief  等待队列有空闲（head为当前写入位置），与Serial_BSP中的等待一样计入通道串口的统计信息
+  */
+static void _UARTMuxWait(UARTMuxChannel * ch, uint16_t head)
+{
+#ifdef UART_STATS
+  uint32_t start = UART_STATS_CYCLES();
+  uint32_t cycles;
+#endif
+
+  ch->port->stats.txWait++;
+  while((uint16_t)(head - ch->tail) > ch->mask);
+
+#ifdef UART_STATS
+  cycles = UART_STATS_CYCLES() - start;
+  UART_STATS_ADD(ch->port->stats.waitCycles, cycles);
+  UART_STATS_ADD(ch->port->stats.callWait, cycles);
+#endif
+}
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
@@ -0,0 +1,143 @@
+/**
+  **************************************************************
+  * @file       UARTMux.h
+  * @author	    高明飞
+  * @version    V0.1
+  * @date       2026-10-18
+  *
+  * @brief      单个串口上的多路虚拟通道
+  *
+  * @details
+  * @verbatim
+  * 调试日志、二进制遥测、命令行等共用一个串口时，大量日志会长时间占用串口。
+  * 本模块为每个虚拟通道提供独立的发送队列和一个UARTPort串口对象，
+  * 所有UARTPortSend*、UARTPortPrintf、UARTLogSend、UARTDeltaSend等函数
+  * 都可以直接发送到某个通道。物理串口的发送中断中调用UARTMuxTxISR，
+  * 按下面的规则从各通道队列中取数据发送：
+  *   - 优先通道（priority不为0）有数据时总是先发送，两个字节之间即可切换，
+  *     延迟不超过一个字节加一个通道头的时间；
+  *   - 其他通道按加权差额轮询（DRR）调度，每轮每个通道最多发送quantum字节，
+  *     带宽按quantum的比例分配，任何通道都不会被其他普通通道饿死。
+  *
+  * 串口上的数据格式（与SLIP相同的转义方法）：
+  *   切换通道时发送通道头 [0xC0][通道号]，之后为该通道的数据，直到下一个通道头；
+  *   数据中的0xC0发送为[0xDB][0xDC]，0xDB发送为[0xDB][0xDD]。
+  * 接收方遇到0xC0即可重新同步。
+  *
+  * 上位机使用Tools/uartmux.py分离各通道的数据。
+  *
+  * 使用方法：
+  *   static uint8_t LogQueue[512], TelQueue[256];
+  *   UARTMux Mux;
+  *   UARTMuxChannel LogCh, TelCh;
+  *   UARTPort LogPort, TelPort;
+  *
+  *   UARTMuxInit(&Mux, &SciOps, (void *)&SciaRegs);
+  *   UARTMuxChannelInit(&Mux, &TelCh, &TelPort, 0, TelQueue, sizeof(TelQueue), 64, 1);
+  *   UARTMuxChannelInit(&Mux, &LogCh, &LogPort, 1, LogQueue, sizeof(LogQueue), 32, 0);
+  *   __interrupt void SciaTxISR(void) { UARTMuxTxISR(&Mux); ... }
+  *
+  *   UARTPortPrintf(&LogPort, "state=%u\r\n", state);
+  *   UARTDeltaSend(&Delta, &TelPort, samples, 16);
+  *
+  * 修改记录：
+  * 2026-10-18 :
+  *   - File Created.
+  *   - 整段发送时队列满的等待也计入txWait及UART_STATS的等待耗时
+  * @endverbatim
+  *
+  * @note
+  * 队列满时发送函数等待发送中断取走数据（计入通道串口的txWait，定义UART_STATS时另计入等待耗时）。
+  ***************************************************************
+  */
+
+#ifndef UARTMUX_H
+#define UARTMUX_H
+
+/* C++ */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "Serial_BSP.h"
+
+/** @addtogroup Serial
+  * @{
+  */
+
+/** @addtogroup UARTMux
+  * @brief      单个串口上的多路虚拟通道
+  * @{
+  */
+
+/*--------------------此部分需要修改--------------------*/
+/**
+  * 最多通道数，通道号为0~UART_MUX_MAX_CHANNELS-1
+  */
+#define UART_MUX_MAX_CHANNELS 4
+/*--------------------此部分需要修改--------------------*/
+
+/** 通道头起始字节 */
+#define UART_MUX_SYNC     0xC0
+/** 转义字节 */
+#define UART_MUX_ESC      0xDB
+/** 0xC0转义后的第二个字节 */
+#define UART_MUX_ESC_SYNC 0xDC
+/** 0xDB转义后的第二个字节 */
+#define UART_MUX_ESC_ESC  0xDD
+
+struct UARTMux_t;
+
+/**
+  * @brief  虚拟通道
+  */
+typedef struct
+{
+  struct UARTMux_t * mux;       /*!<所属的多路复用对象 */
+  UARTPort * port;              /*!<通道的串口对象，队列满的等待计入其统计信息 */
+  uint8_t * buffer;             /*!<发送队列，大小为2的整数次幂 */
+  uint16_t mask;                /*!<发送队列大小 - 1 */
+  volatile uint16_t head;       /*!<队列写入位置 */
+  volatile uint16_t tail;       /*!<队列读取位置，由发送中断更新 */
+  uint16_t quantum;             /*!<每轮最多发送的字节数（权重） */
+  int16_t deficit;              /*!<本轮剩余可发送的字节数 */
+  uint8_t id;                   /*!<通道号 */
+  uint8_t priority;             /*!<不为0时为优先通道 */
+  uint32_t wireBytes;           /*!<实际发送的字节数，包括通道头和转义 */
+} UARTMuxChannel;
+
+/**
+  * @brief  多路复用对象
+  */
+typedef struct UARTMux_t
+{
+  const UARTPortOps * ops;                      /*!<物理串口的底层操作，TxIntEnable不能为空 */
+  void * hw;                                    /*!<物理串口底层操作使用的参数 */
+  UARTMuxChannel * ch[UART_MUX_MAX_CHANNELS];   /*!<各通道，未使用时为空 */
+  uint8_t cur;                                  /*!<当前调度的通道号 */
+  uint8_t wire;                                 /*!<串口上当前的通道号，0xFF表示尚未发送通道头 */
+  uint8_t pend[2];                              /*!<待发送的通道头或转义字节 */
+  uint8_t pendNum;                              /*!<pend中待发送的字节数 */
+} UARTMux;
+
+ErrorStatus UARTMuxInit(UARTMux * mux, const UARTPortOps * ops, void * hw);
+
+ErrorStatus UARTMuxChannelInit(UARTMux * mux, UARTMuxChannel * ch, UARTPort * port, uint8_t id,
+                               uint8_t * buffer, uint16_t size, uint16_t quantum, uint8_t priority);
+
+void UARTMuxTxISR(UARTMux * mux);
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/* C++ */
+#ifdef __cplusplus
+}
+#endif
+
+#endif
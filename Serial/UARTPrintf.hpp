@@ -0,0 +1,268 @@
+/**
+  **************************************************************
+  * @file       UARTPrintf.hpp
+  * @author	    高明飞
+  * @version    V0.1
+  * @date       2026-10-18
+  *
+  * @brief      编译期解析格式化字符串的UARTprintf (C++)
+  *
+  * @details
+  * @verbatim
+  * UARTprintf每次调用都要在运行时逐个字符扫描格式化字符串。
+  * 本文件在编译期完成解析，每次调用展开为固定的一串发送函数调用：
+  *   - 两个占位符之间的普通字符用一次UARTSendByteArray发送；
+  *   - 每个占位符直接调用对应的UARTSend*函数；
+  *   - 参数个数、参数类型在编译期检查，不符合时编译报错。
+  *
+  * 使用方法（需要C++14）：
+  *   UART_PRINTF("adc=%u temp=%d\r\n", adc, temp);           使用默认串口
+  *   UART_PORT_PRINTF(&DebugPort, "adc=%u\r\n", adc);       使用指定串口
+  *
+  * 占位符及输出格式与UARTprintf完全相同，未定义的占位符按字符原样发送。
+  *
+  * 修改记录：
+  * 2026-10-18 :
+  *   - File Created.
+  *   - 增加UART_PORT_PRINTF，支持指定串口
+  *   - 支持%f、%.Nf，未定义UART_NO_FLOAT时可用
+  * @endverbatim
+  *
+  * @note
+  * 宏中使用了##__VA_ARGS__，需要编译器支持此扩展（GCC、Clang、ARMCC、TI CGT均支持）。
+  ***************************************************************
+  */
+
+#ifndef UARTPRINTF_HPP
+#define UARTPRINTF_HPP
+
+#include <type_traits>
+
+#include "Serial_BSP.h"
+
+/** @addtogroup Serial
+  * @{
+  */
+
+/** @addtogroup UARTPrintf
+  * @brief      编译期解析格式化字符串的UARTprintf
+  * @{
+  */
+
+/**
+  * 格式化输出到指定串口，format必须为字符串常量
+  */
+#define UART_PORT_PRINTF(port, format, ...)                                   \
+  ::uart::Printf([] {                                                         \
+    struct UARTFormat { static constexpr const char * Str() { return format; } }; \
+    return UARTFormat();                                                      \
+  }(), (port), ##__VA_ARGS__)
+
+/**
+  * 格式化输出到默认串口，format必须为字符串常量
+  */
+#define UART_PRINTF(format, ...) UART_PORT_PRINTF(&UARTDefaultPort, format, ##__VA_ARGS__)
+
+namespace uart
+{
+namespace detail
+{
+
+/* 是否为支持的占位符 */
+constexpr bool IsSpec(char c)
+{
+#ifndef UART_NO_FLOAT
+  return c == 'd' || c == 'u' || c == 'x' || c == 'b' || c == 'c' || c == 's' || c == 'f';
+#else
+  return c == 'd' || c == 'u' || c == 'x' || c == 'b' || c == 'c' || c == 's';
+#endif
+}
+
+/* s[pos]为'%'时，是否为%.Nf */
+constexpr bool IsPrecSpec(const char * s, unsigned pos)
+{
+#ifndef UART_NO_FLOAT
+  return s[pos + 1] == '.' && s[pos + 2] >= '0' && s[pos + 2] <= '9' && s[pos + 3] == 'f';
+#else
+  return false;
+#endif
+}
+
+/* 从pos开始查找下一个占位符的'%'位置，找不到时返回字符串结尾位置 */
+constexpr unsigned NextSpec(const char * s, unsigned pos)
+{
+  return s[pos] == '\0' ? pos :
+         s[pos] != '%' ? NextSpec(s, pos + 1) :
+         s[pos + 1] == '\0' ? pos + 1 :
+         IsSpec(s[pos + 1]) || IsPrecSpec(s, pos) ? pos : NextSpec(s, pos + 2);
+}
+
+/* 占位符的长度，%.Nf为4，其他为2 */
+constexpr unsigned SpecLen(const char * s, unsigned pos)
+{
+  return IsPrecSpec(s, pos) ? 4 : 2;
+}
+
+/* %f的小数位数 */
+constexpr unsigned SpecPrec(const char * s, unsigned pos)
+{
+  return IsPrecSpec(s, pos) ? static_cast<unsigned>(s[pos + 2] - '0') : UART_FLOAT_PRECISION;
+}
+
+/* 是否为不超过32位的整数类型，UARTprintf的va_arg(ap, uint32_t)只能正确处理这类参数 */
+template <class T>
+struct IsInt32
+{
+  static constexpr bool value = std::is_integral<T>::value && sizeof(T) <= 4;
+};
+
+/* 发送一段普通字符 */
+inline void SendLiteral(UARTPort * port, const char * s, unsigned len)
+{
+  if(len != 0)
+    UARTPortSendByteArray(port, reinterpret_cast<const uint8_t *>(s), static_cast<uint16_t>(len));
+}
+
+/* 各占位符对应的发送方法 */
+template <char C>
+struct Spec;
+
+template <>
+struct Spec<'d'>
+{
+  template <class T>
+  static void Send(UARTPort * port, T v)
+  {
+    static_assert(IsInt32<T>::value, "%d requires an integer of at most 32 bits");
+    UARTPortSendSignASCII(port, static_cast<int32_t>(v), 0);
+  }
+};
+
+template <>
+struct Spec<'u'>
+{
+  template <class T>
+  static void Send(UARTPort * port, T v)
+  {
+    static_assert(IsInt32<T>::value, "%u requires an integer of at most 32 bits");
+    UARTPortSendUnsignASCII(port, static_cast<uint32_t>(v), 10, 0);
+  }
+};
+
+template <>
+struct Spec<'x'>
+{
+  template <class T>
+  static void Send(UARTPort * port, T v)
+  {
+    static_assert(IsInt32<T>::value, "%x requires an integer of at most 32 bits");
+    const uint32_t tmp = static_cast<uint32_t>(v);
+    UARTPortSendUnsignASCII(port, tmp, 16, tmp <= 0xFF ? 2 : tmp <= 0xFFFF ? 4 : 8);
+  }
+};
+
+template <>
+struct Spec<'b'>
+{
+  template <class T>
+  static void Send(UARTPort * port, T v)
+  {
+    static_assert(IsInt32<T>::value, "%b requires an integer of at most 32 bits");
+    const uint32_t tmp = static_cast<uint32_t>(v);
+    UARTPortSendUnsignASCII(port, tmp, 2, tmp <= 0xFF ? 8 : tmp <= 0xFFFF ? 16 : 32);
+  }
+};
+
+template <>
+struct Spec<'c'>
+{
+  template <class T>
+  static void Send(UARTPort * port, T v)
+  {
+    static_assert(std::is_integral<T>::value, "%c requires a character");
+    UARTPortSendChar(port, static_cast<char>(v));
+  }
+};
+
+template <>
+struct Spec<'s'>
+{
+  static void Send(UARTPort * port, const char * v)
+  {
+    UARTPortSendString(port, v);
+  }
+};
+
+/* 按占位符发送一个参数，Prec只用于%f */
+template <char C, unsigned Prec>
+struct SpecPrecision
+{
+  template <class T>
+  static void Send(UARTPort * port, T v)
+  {
+    Spec<C>::Send(port, v);
+  }
+};
+
+#ifndef UART_NO_FLOAT
+template <unsigned Prec>
+struct SpecPrecision<'f', Prec>
+{
+  template <class T>
+  static void Send(UARTPort * port, T v)
+  {
+    static_assert(std::is_arithmetic<T>::value, "%f requires a number");
+    UARTPortSendFloat(port, static_cast<float>(v), static_cast<uint8_t>(Prec));
+  }
+};
+#endif
+
+/* 没有剩余参数：发送剩余普通字符 */
+template <class F, unsigned Pos>
+inline void Emit(UARTPort * port)
+{
+  constexpr unsigned spec = NextSpec(F::Str(), Pos);
+  static_assert(F::Str()[spec] == '\0', "UART_PRINTF: too few arguments for format");
+  SendLiteral(port, F::Str() + Pos, spec - Pos);
+}
+
+/* 发送下一个占位符之前的普通字符和该占位符 */
+template <class F, unsigned Pos, class T, class... Rest>
+inline void Emit(UARTPort * port, T arg, Rest... rest)
+{
+  constexpr unsigned spec = NextSpec(F::Str(), Pos);
+  static_assert(F::Str()[spec] != '\0', "UART_PRINTF: too many arguments for format");
+  constexpr unsigned len = SpecLen(F::Str(), spec);
+  SendLiteral(port, F::Str() + Pos, spec - Pos);
+  SpecPrecision<F::Str()[spec + len - 1], SpecPrec(F::Str(), spec)>::Send(port, arg);
+  Emit<F, spec + len>(port, rest...);
+}
+
+} /* namespace detail */
+
+/**
+  * @brief  格式化输出，由UART_PORT_PRINTF宏调用
+  *
+  * @param  format: 提供格式化字符串的类型，Str()返回字符串常量
+  * @param  port:   串口对象指针
+  * @param  args:   参数
+  *
+  * @retval void
+  */
+template <class F, class... Args>
+inline void Printf(F, UARTPort * port, Args... args)
+{
+  detail::Emit<F, 0>(port, args...);
+}
+
+} /* namespace uart */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+#endif
@@ -0,0 +1,290 @@
+/**
+  **************************************************************
+  * @file       UARTRx.c
+  * @author	    高明飞
+  * @version    V0.1
+  * @date       2026-10-18
+  *
+  * @brief      中断方式串口接收及分帧
+  *
+  * @details
+  * @verbatim
+  * 接收中断将数据存入环形缓存，主循环逐字节解析并以视图形式回调完整帧。
+  *
+  * 下标head、tail、scan、start均为自由增长的16位数，使用时与mask相与，
+  * head - tail 即为缓存中的字节数。
+  * 空闲中断的帧结束位置存入idleHead队列，只由中断写入idleIn、只由主循环写入idleOut，
+  * 不需要临界区。
+  *
+  * 修改记录：
+  * 2026-10-18 :
+  *   - File Created.
+  * @endverbatim
+  ***************************************************************
+  */
+
+/** @addtogroup Serial
+  * @{
+  */
+
+/** @addtogroup UARTRx
+  * @{
+  */
+
+#include "UARTRx.h"
+
+/* 内部使用的函数声明 */
+static void _UARTRxEmit(UARTRx * rx, uint16_t begin, uint16_t end);
+static void _UARTRxRelease(UARTRx * rx, uint16_t pos);
+
+/**
+  * @brief  初始化接收对象
+  *
+  * @param  rx:       接收对象指针
+  * @param  buffer:   环形缓存
+  * @param  size:     缓存大小，必须为2的整数次幂，且不大于32768
+  * @param  mode:     分帧方式
+  * @param  callback: 帧回调函数
+  * @param  arg:      回调函数参数
+  *
+  * @retval SUCCESS 执行成功
+  * @retval ERROR   缓存大小不符合要求
+  */
+ErrorStatus UARTRxInit(UARTRx * rx, uint8_t * buffer, uint16_t size,
+                       UARTRxMode mode, UARTRxCallback callback, void * arg)
+{
+  if(size < 2 || size > 32768 || (size & (size - 1)) != 0)
+    return ERROR;
+
+  rx->Buffer = buffer;
+  rx->mask = size - 1;
+  rx->head = 0;
+  rx->tail = 0;
+  rx->idleIn = 0;
+  rx->idleOut = 0;
+  rx->scan = 0;
+  rx->start = 0;
+  rx->need = 0;
+  rx->state = 0;
+
+  rx->mode = mode;
+  rx->delimiter = '\n';
+  rx->lengthSize = 1;
+  rx->maxFrame = size / 2;
+  rx->callback = callback;
+  rx->arg = arg;
+
+  rx->overrun = 0;
+  rx->frames = 0;
+  rx->dropped = 0;
+
+  return SUCCESS;
+}
+
+/**
+  * @brief  接收中断中调用，存入一个字节
+  *
+  * @param  rx: 接收对象指针
+  * @param  c:  接收到的字节
+  *
+  * @retval None
+  *
+  * @note   缓存已满时丢弃该字节，并增加overrun计数
+  */
+void UARTRxISR(UARTRx * rx, uint8_t c)
+{
+  uint16_t head = rx->head;
+
+  if((uint16_t)(head - rx->tail) > rx->mask)
+  {
+    rx->overrun++;
+    return;
+  }
+
+  rx->Buffer[head & rx->mask] = c;
+  rx->head = head + 1;
+}
+
+/**
+  * @brief  线路空闲中断中调用，标记帧结束
+  *
+  * @param  rx: 接收对象指针
+  *
+  * @retval None
+  *
+  * @note   只在UART_RX_IDLE模式下有效；两次UARTRxPoll之间最多记录UART_RX_IDLE_QUEUE次
+  */
+void UARTRxIdleISR(UARTRx * rx)
+{
+  uint8_t in = rx->idleIn;
+
+  /* 队列已满时更新最后一个位置，最后两帧合并 */
+  if((uint8_t)(in - rx->idleOut) >= UART_RX_IDLE_QUEUE)
+    in--;
+  else
+    rx->idleIn = in + 1;
+  rx->idleHead[in & (UART_RX_IDLE_QUEUE - 1)] = rx->head;
+}
+
+/**
+  * @brief  解析已接收的数据，得到完整帧时调用回调函数
+  *
+  * @param  rx: 接收对象指针
+  *
+  * @retval None
+  *
+  * @note   在主循环中调用，不可与同一接收对象的其他UARTRxPoll调用并发
+  */
+void UARTRxPoll(UARTRx * rx)
+{
+  uint16_t head, idleHead;
+  uint8_t c;
+
+  if(rx->mode == UART_RX_IDLE)
+  {
+    /* 依次处理每次空闲中断记录的帧结束位置 */
+    while(rx->idleOut != rx->idleIn)
+    {
+      idleHead = rx->idleHead[rx->idleOut & (UART_RX_IDLE_QUEUE - 1)];
+      rx->idleOut++;
+      if(idleHead == rx->start)
+        continue;
+      if((uint16_t)(idleHead - rx->start) > rx->maxFrame)
+        rx->dropped++;
+      else
+        _UARTRxEmit(rx, rx->start, idleHead);
+      _UARTRxRelease(rx, idleHead);
+    }
+    return;
+  }
+
+  UART_RX_ENTER_CRITICAL();
+  head = rx->head;
+  UART_RX_EXIT_CRITICAL();
+
+  while(rx->scan != head)
+  {
+    c = rx->Buffer[rx->scan & rx->mask];
+    rx->scan++;
+
+    if(rx->mode == UART_RX_DELIMITER)
+    {
+      /* state为1时表示正在丢弃超长帧 */
+      if(c == rx->delimiter)
+      {
+        if(rx->state == 0)
+          _UARTRxEmit(rx, rx->start, rx->scan - 1);
+        _UARTRxRelease(rx, rx->scan);
+      }
+      else if(rx->state != 0 || (uint16_t)(rx->scan - rx->start) > rx->maxFrame)
+      {
+        /* 超长，丢弃已接收部分，直到下一个结束符 */
+        if(rx->state == 0)
+          rx->dropped++;
+        _UARTRxRelease(rx, rx->scan);
+        rx->state = 1;
+      }
+      continue;
+    }
+
+    /* UART_RX_LENGTH */
+    if(rx->state < rx->lengthSize)
+    {
+      rx->need = (rx->need << 8) | c;
+      if(++rx->state < rx->lengthSize)
+        continue;
+
+      if(rx->need > rx->maxFrame)
+      {
+        /* 长度错误，丢弃帧头，从下一个字节重新开始 */
+        rx->dropped++;
+        _UARTRxRelease(rx, rx->scan);
+        continue;
+      }
+      if(rx->need != 0)
+        continue;
+    }
+    else if(--rx->need != 0)
+    {
+      continue;
+    }
+
+    _UARTRxEmit(rx, rx->start + rx->lengthSize, rx->scan);
+    _UARTRxRelease(rx, rx->scan);
+  }
+}
+
+/**
+  * @brief  将帧视图中的数据复制到连续缓存
+  *
+  * @param  frame: 帧视图
+  * @param  dst:   目标缓存
+  * @param  size:  目标缓存大小
+  *
+  * @retval 复制的字节数
+  */
+uint16_t UARTRxViewCopy(const UARTRxView * frame, uint8_t * dst, uint16_t size)
+{
+  uint16_t n = 0;
+  uint8_t seg;
+  uint16_t i;
+
+  for(seg = 0; seg < 2; seg++)
+    for(i = 0; i < frame->length[seg] && n < size; i++)
+      dst[n++] = frame->data[seg][i];
+
+  return n;
+}
+
+/**
+  * @brief  以视图形式回调[begin, end)之间的数据
+  */
+static void _UARTRxEmit(UARTRx * rx, uint16_t begin, uint16_t end)
+{
+  UARTRxView view;
+  uint16_t offset = begin & rx->mask;
+  uint16_t len = end - begin;
+  uint16_t first = rx->mask + 1 - offset;
+
+  rx->frames++;
+  if(rx->callback == 0)
+    return;
+
+  view.data[0] = rx->Buffer + offset;
+  view.data[1] = rx->Buffer;
+  if(len <= first)
+  {
+    view.length[0] = len;
+    view.length[1] = 0;
+  }
+  else
+  {
+    view.length[0] = first;
+    view.length[1] = len - first;
+  }
+
+  rx->callback(&view, rx->arg);
+}
+
+/**
+  * @brief  释放pos之前的缓存，并从pos开始新的一帧
+  */
+static void _UARTRxRelease(UARTRx * rx, uint16_t pos)
+{
+  rx->start = pos;
+  rx->scan = pos;
+  rx->state = 0;
+  rx->need = 0;
+
+  UART_RX_ENTER_CRITICAL();
+  rx->tail = pos;
+  UART_RX_EXIT_CRITICAL();
+}
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
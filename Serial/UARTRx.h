@@ -0,0 +1,166 @@
+/**
+  **************************************************************
+  * @file       UARTRx.h
+  * @author	    高明飞
+  * @version    V0.1
+  * @date       2026-10-18
+  *
+  * @brief      中断方式串口接收及分帧
+  *
+  * @details
+  * @verbatim
+  * 接收中断中调用UARTRxISR将数据存入环形缓存，只做一次写入和一次下标更新；
+  * 主循环中调用UARTRxPoll逐字节解析，得到完整帧后调用回调函数。
+  * 回调函数收到的是指向环形缓存的视图（最多两段，缓存回绕时分为两段），
+  * 不进行数据复制，回调返回后这段缓存才被释放。
+  *
+  * 支持三种分帧方式：
+  *   UART_RX_DELIMITER : 以指定字节作为帧结束符，结束符不包含在帧中
+  *   UART_RX_LENGTH    : 帧头为1或2字节长度（高字节在前），长度不包含帧头
+  *   UART_RX_IDLE      : 以线路空闲作为帧结束，需在空闲中断中调用UARTRxIdleISR
+  *
+  * 使用方法（以TMS320F28027为例）：
+  *   static uint8_t RxBuffer[256];
+  *   static UARTRx Rx;
+  *   UARTRxInit(&Rx, RxBuffer, sizeof(RxBuffer), UART_RX_DELIMITER, OnFrame, 0);
+  *   Rx.delimiter = '\n';
+  *
+  *   __interrupt void SciaRxISR(void)
+  *   {
+  *     UARTRxISR(&Rx, SciaRegs.SCIRXBUF.all);
+  *     ...
+  *   }
+  *
+  *   while(1) { UARTRxPoll(&Rx); ... }
+  *
+  * 修改记录：
+  * 2026-10-18 :
+  *   - File Created.
+  *   - 空闲中断的帧结束位置改为存入队列，两次UARTRxPoll之间的多次空闲中断不再合并为一帧
+  * @endverbatim
+  *
+  * @note
+  * 环形缓存大小必须为2的整数次幂，且不大于32768。
+  * 中断中每字节只有一次比较、一次写入和一次加法，Cortex-M0 @48MHz下约20个时钟周期，
+  * 1Mbaud时每字节间隔约480个时钟周期；主循环只需保证在缓存填满之前调用UARTRxPoll。
+  ***************************************************************
+  */
+
+#ifndef UARTRX_H
+#define UARTRX_H
+
+/* C++ */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "Serial_BSP.h"
+
+/** @addtogroup Serial
+  * @{
+  */
+
+/** @addtogroup UARTRx
+  * @brief      中断方式串口接收及分帧
+  * @{
+  */
+
+/*--------------------此部分需要修改--------------------*/
+/**
+  * 进入/退出临界区。
+  * 8位和16位MCU上读取16位下标不是原子操作，需要在此关闭/打开接收中断；
+  * 32位MCU可定义为空。
+  */
+#define UART_RX_ENTER_CRITICAL()
+#define UART_RX_EXIT_CRITICAL()
+
+/**
+  * UART_RX_IDLE模式下两次UARTRxPoll之间最多记录的空闲中断次数，2的整数次幂且不大于128。
+  * 超过时最后一次记录的帧结束位置被更新，最后两帧合并为一帧
+  */
+#define UART_RX_IDLE_QUEUE 4
+/*--------------------此部分需要修改--------------------*/
+
+/** 分帧方式 */
+typedef enum
+{
+  UART_RX_DELIMITER,  /**< 以结束符分帧 */
+  UART_RX_LENGTH,     /**< 以长度前缀分帧 */
+  UART_RX_IDLE        /**< 以线路空闲分帧 */
+} UARTRxMode;
+
+/**
+  * @brief  接收帧视图，指向环形缓存中的数据
+  *
+  * @detail
+  * 缓存未回绕时length[1]为0。
+  */
+typedef struct
+{
+  const uint8_t * data[2];    /*!<两段数据的头指针 */
+  uint16_t length[2];         /*!<两段数据的长度 */
+} UARTRxView;
+
+/**
+  * @brief  帧回调函数
+  *
+  * @param  frame: 帧视图，只在回调函数执行期间有效
+  * @param  arg:   UARTRxInit时指定的参数
+  */
+typedef void (*UARTRxCallback)(const UARTRxView * frame, void * arg);
+
+/**
+  * @brief  接收对象
+  */
+typedef struct UARTRx_t
+{
+  uint8_t * Buffer;             /*!<环形缓存 */
+  uint16_t mask;                /*!<缓存大小 - 1 */
+  volatile uint16_t head;       /*!<写入位置，由中断更新 */
+  volatile uint16_t tail;       /*!<已释放位置，由主循环更新 */
+  volatile uint16_t idleHead[UART_RX_IDLE_QUEUE];  /*!<各次空闲中断时的写入位置 */
+  volatile uint8_t idleIn;      /*!<空闲中断次数，由中断更新 */
+  uint8_t idleOut;              /*!<已处理的空闲中断次数，由主循环更新 */
+  uint16_t scan;                /*!<解析位置 */
+  uint16_t start;               /*!<当前帧起始位置 */
+  uint16_t need;                /*!<UART_RX_LENGTH模式下，还需接收的字节数 */
+  uint8_t state;                /*!<解析状态：UART_RX_LENGTH模式下为已接收的帧头字节数，
+                                    UART_RX_DELIMITER模式下为1表示正在丢弃超长帧 */
+
+  UARTRxMode mode;              /*!<分帧方式 */
+  uint8_t delimiter;            /*!<UART_RX_DELIMITER模式下的结束符，默认为'\n' */
+  uint8_t lengthSize;           /*!<UART_RX_LENGTH模式下帧头字节数，1或2，默认为1 */
+  uint16_t maxFrame;            /*!<最大帧长度，超过时丢弃，默认为缓存大小的一半 */
+  UARTRxCallback callback;      /*!<帧回调函数 */
+  void * arg;                   /*!<回调函数参数 */
+
+  volatile uint32_t overrun;    /*!<缓存满时丢弃的字节数 */
+  uint32_t frames;              /*!<收到的帧数 */
+  uint32_t dropped;             /*!<超长丢弃的帧数 */
+} UARTRx;
+
+ErrorStatus UARTRxInit(UARTRx * rx, uint8_t * buffer, uint16_t size,
+                       UARTRxMode mode, UARTRxCallback callback, void * arg);
+
+void UARTRxISR(UARTRx * rx, uint8_t c);
+
+void UARTRxIdleISR(UARTRx * rx);
+
+void UARTRxPoll(UARTRx * rx);
+
+uint16_t UARTRxViewCopy(const UARTRxView * frame, uint8_t * dst, uint16_t size);
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/* C++ */
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,57 @@
+/**
+  **************************************************************
+  * @file       UARTVarint.c
+  * @author	    高明飞
+  * @version    V0.1
+  * @date       2026-10-18
+  *
+  * @brief      varint (LEB128) 及zigzag编码
+  *
+  * @details
+  * @verbatim
+  * 修改记录：
+  * 2026-10-18 :
+  *   - File Created，UARTVarintEncode由UARTLog.c移入.
+  * @endverbatim
+  ***************************************************************
+  */
+
+/** @addtogroup Serial
+  * @{
+  */
+
+/** @addtogroup UARTVarint
+  * @{
+  */
+
+#include "UARTVarint.h"
+
+/**
+  * @brief  将一个32位无符号数编码为varint (LEB128)
+  *
+  * @param  value: 需要编码的数据
+  * @param  out:   编码结果存放位置，至少UART_VARINT_MAX个字节
+  *
+  * @retval 编码后的字节数，1~5
+  */
+uint8_t UARTVarintEncode(uint32_t value, uint8_t * out)
+{
+  uint8_t n = 0;
+
+  while(value >= 0x80)
+  {
+    out[n++] = (uint8_t)(value & 0x7F) | 0x80;
+    value >>= 7;
+  }
+  out[n++] = (uint8_t)value;
+
+  return n;
+}
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
@@ -0,0 +1,70 @@
+/**
+  **************************************************************
+  * @file       UARTVarint.h
+  * @author	    高明飞
+  * @version    V0.1
+  * @date       2026-10-18
+  *
+  * @brief      varint (LEB128) 及zigzag编码
+  *
+  * @details
+  * @verbatim
+  * UARTLog、UARTDelta共用的变长整数编码，不依赖消息定义文件及串口对象。
+  *   varint : 每字节低7位为数据，低位在前，最高位为1表示后面还有字节
+  *   zigzag : 0, -1, 1, -2, 2... 映射为 0, 1, 2, 3, 4...，小的负数编码后也很小
+  *
+  * 修改记录：
+  * 2026-10-18 :
+  *   - File Created.
+  * @endverbatim
+  ***************************************************************
+  */
+
+#ifndef UARTVARINT_H
+#define UARTVARINT_H
+
+/* C++ */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* 如未定义uint8_t等基本数据类型，需要先定义；SERIAL_HOST时由Serial_Host.h包含 */
+#ifdef SERIAL_HOST
+#include "Serial_Host.h"
+#else
+#include "TypeDef.h"
+#endif
+
+/** @addtogroup Serial
+  * @{
+  */
+
+/** @addtogroup UARTVarint
+  * @brief      varint (LEB128) 及zigzag编码
+  * @{
+  */
+
+/** 32位数varint编码后的最大字节数 */
+#define UART_VARINT_MAX 5
+
+/**
+  * 将32位有符号数（以uint32_t表示，按补码）做zigzag映射，结果为uint32_t
+  */
+#define UART_ZIGZAG32(d) (((uint32_t)(d) << 1) ^ (0 - ((uint32_t)(d) >> 31)))
+
+uint8_t UARTVarintEncode(uint32_t value, uint8_t * out);
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/* C++ */
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -19,8 +19,7 @@
  * 目前未实现以下功能：\n
  * 1.语音编解码功能\n
  * 2.语音识别功能\n
- * 3.文本缓存功能\n
- * 4.省电模式（此部分功能数据手册给出的信息不全，进入省电模式后唤醒有问题）\n
+ * 3.省电模式（此部分功能数据手册给出的信息不全，进入省电模式后唤醒有问题）\n
  *
  * 修改记录：\n
  *
@@ -29,6 +28,17 @@
  *
  * 2015-09-27 :\n
  *   -为内部函数增加static限定\n
+ *
+ * 2026-10-18 :\n
+ *   -帧长度改为16位，XFS_BUFFER_SIZE不再限制为小于100\n
+ *   -增加XFS5152CE_Speak及XFS5152CE_Stream_*，任意长度文本按标点拆分为多帧，
+ *    根据BUSY引脚在上一帧合成结束时立即发送下一帧\n
+ *   -流式合成等待BUSY变为高电平超时后改用状态查询，拆分时每帧至少XFS_STREAM_MIN_CHARS个字符\n
+ *   -流式合成改为在第一个标点符号处拆分，缩短每次帧间停顿\n
+ *   -增加XFS5152CE_Cache_Start、XFS5152CE_Cache_Speak，文本分块写入芯片的文本缓存后整段播放，
+ *    段内没有帧间停顿\n
+ *   -XFS5152CE_Start的字符个数改为16位，与XFS_BUFFER_SIZE的范围一致\n
+ *   -列出底层需要实现的全部操作，包括XFS5152CE_SEND_FRAME及HAL_I2C_TICKS计时\n
  * 
  */
  
@@ -51,6 +61,9 @@
 /* 芯片空闲 */
 #define XFS_RE_Ready 0x4F
 
+/* 等待BUSY变为高电平超时的计数值 */
+#define XFS_STREAM_BUSY_TICKS (HAL_I2C_TICK_HZ / 1000UL * XFS_STREAM_BUSY_TIMEOUT)
+
 /*
  * 命令字 
  */
@@ -64,6 +77,13 @@
 #define XFS_CMD_Resume 0x04
 /* 开始合成命令 */
 #define XFS_CMD_Start 0x01
+/* 写入文本缓存，参数为起始块号0~15 */
+#define XFS_CMD_Cache 0x31
+/* 播放文本缓存，参数高4位为重复次数，低4位为编码格式 */
+#define XFS_CMD_CachePlay 0x32
+
+/* 文本缓存每块的字节数，每块用一帧写入 */
+#define XFS_CACHE_BLOCK 256
 
 /*
  * 编码格式
@@ -78,13 +98,38 @@
 static uint8_t XFS_Buffer[XFS_BUFFER_SIZE + 5];
 static uint8_t XFS_tmpRe;
 
+/* 流式合成：尚未发送的文本、字符个数 */
+static const uint8_t * XFS_StreamData;
+static uint16_t XFS_StreamLeft;
+/* 流式合成：发送后的BUSY状态，0为尚未看到高电平，1为已看到高电平，2为等待超时、改用状态查询 */
+static uint8_t XFS_StreamBusy;
+/* 流式合成：等待BUSY变为高电平的上一次计数值及已等待的计数值 */
+static uint16_t XFS_StreamT0;
+static uint32_t XFS_StreamWait;
+/* 流式合成：为1时每段写入文本缓存后播放（XFS5152CE_Cache_Start） */
+static uint8_t XFS_StreamCache;
+
 /* Internal Functions */
 /* 发送一条命令 */
 XFSResult _XF_SendCMD(uint8_t CMD);
 /* 获取芯片返回值 */
 XFSResult _XF_GetResult();
+/* 状态查询，芯片空闲时返回XFSOK */
+XFSResult _XF_QueryReady();
 /* 生成提示音基本部分数据 */
 void _XF_FillTone();
+/* 流式合成：发送下一帧 */
+XFSResult _XF_StreamSend();
+/* 流式合成：下一帧的字符个数 */
+uint16_t _XF_StreamChunk();
+/* 流式合成：下一段写入文本缓存的字符个数 */
+uint16_t _XF_CacheChunk();
+/* 将XFCount个字符写入文本缓存并播放 */
+XFSResult _XF_CachePlay(const uint8_t * XFData, uint16_t XFCount);
+/* 阻塞调用XFS5152CE_Stream_Poll，直到所有帧已发送 */
+XFSResult _XF_StreamFinish();
+/* 是否为可以拆分的标点符号 */
+uint8_t _XF_IsBreak(uint16_t XFChar);
 
 
 /**
@@ -168,7 +213,7 @@ XFSResult XFS5152CE_Resume()
 }
 
 /**
- * 停止语音合成
+ * 停止语音合成，流式合成时同时结束流式合成
  * 
  * \return 函数执行结果
  * \retval XFSOK: 函数执行正常
@@ -176,6 +221,7 @@ XFSResult XFS5152CE_Resume()
  */
 XFSResult XFS5152CE_Stop()
 {
+	XFS_StreamLeft = 0;
 	return _XF_SendCMD(XFS_CMD_Stop);
 }
 
@@ -183,7 +229,7 @@ XFSResult XFS5152CE_Stop()
  * 开始语音合成
  * 
  * \param XFData: 待合成数据头指针
- * \param XFCount: 待合成数据个数，需小于XFS_BUFFER_SIZE / 2
+ * \param XFCount: 待合成数据个数，不能超过XFS_BUFFER_SIZE / 2
  *
  * \note XFCount为实际中文字符字数，不是字节数，一般XFCount为字节数的一半
  * 
@@ -191,27 +237,166 @@ XFSResult XFS5152CE_Stop()
  * \retval XFSOK: 函数执行正常
  * \retval XFSERROR: 函数执行异常
  */
-XFSResult XFS5152CE_Start(uint8_t * XFData, uint8_t XFCount)
+XFSResult XFS5152CE_Start(uint8_t * XFData, uint16_t XFCount)
 {
-  uint8_t i;
+  uint16_t i;
+  uint16_t len;
   
-  if(2 * XFCount > XFS_BUFFER_SIZE)
+  if(XFCount > XFS_BUFFER_SIZE / 2)
     return XFSERROR;
+  len = 2 * XFCount;
   
+  /* 长度为命令字、编码格式和文本的字节数，高字节在前 */
   XFS_Buffer[0] = XFS_FH;
-  XFS_Buffer[1] = 0x00;
-  XFS_Buffer[2] = 2 * XFCount + 2;
+  XFS_Buffer[1] = (uint8_t)((len + 2) >> 8);
+  XFS_Buffer[2] = (uint8_t)(len + 2);
   XFS_Buffer[3] = XFS_CMD_Start;
   XFS_Buffer[4] = XFS_FORMAT_UNICODE;  /* 使用UNICODE编码 */
-  for(i = 0;i < 2 * XFCount;i++)
+  for(i = 0;i < len;i++)
   {
     XFS_Buffer[i+5] = XFData[i];
   }
 
-  XFS5152CE_SEND_BYTES(XFS_Buffer, 2 * XFCount + 5);
+  XFS5152CE_SEND_BYTES(XFS_Buffer, len + 5);
 	return _XF_GetResult();
 }
 
+/**
+ * 合成任意长度的文本，阻塞直到最后一帧发送完成（此时最后一帧正在合成）。
+ * 文本按XFS_STREAM_CHARS及标点符号拆分为多帧，上一帧合成结束（BUSY变为低电平）时立即发送下一帧
+ *
+ * \param XFData: 待合成文本头指针，UNICODE编码（UTF-16，低字节在前）
+ * \param XFCount: 字符个数（字节数的一半）
+ *
+ * \return 函数执行结果
+ * \retval XFSOK: 函数执行正常
+ * \retval XFSERROR: 函数执行异常，之后的文本不再发送
+ *
+ * \note 文本控制标记（如[v5]）不要跨越拆分位置，可在标记前加标点符号
+ */
+XFSResult XFS5152CE_Speak(const uint8_t * XFData, uint16_t XFCount)
+{
+	if(XFS5152CE_Stream_Start(XFData, XFCount) != XFSOK)
+		return XFSERROR;
+	return _XF_StreamFinish();
+}
+
+/**
+ * 通过芯片的文本缓存合成任意长度的文本，阻塞直到最后一段开始播放。
+ * 文本按XFS_CACHE_CHARS分段，每段写入缓存后整段播放，段内没有帧间停顿
+ *
+ * \param XFData: 待合成文本头指针，UNICODE编码（UTF-16，低字节在前）
+ * \param XFCount: 字符个数（字节数的一半）
+ *
+ * \return 函数执行结果
+ * \retval XFSOK: 函数执行正常
+ * \retval XFSERROR: 函数执行异常，之后的文本不再发送
+ *
+ * \note 文本控制标记（如[v5]）不要跨越分段位置
+ */
+XFSResult XFS5152CE_Cache_Speak(const uint8_t * XFData, uint16_t XFCount)
+{
+	if(XFS5152CE_Cache_Start(XFData, XFCount) != XFSOK)
+		return XFSERROR;
+	return _XF_StreamFinish();
+}
+
+/**
+ * 开始流式合成，发送第一帧后立即返回，之后在主循环中调用XFS5152CE_Stream_Poll发送其余各帧
+ *
+ * \param XFData: 待合成文本头指针，UNICODE编码（UTF-16，低字节在前），合成期间需保持有效
+ * \param XFCount: 字符个数（字节数的一半）
+ *
+ * \return 函数执行结果
+ * \retval XFSOK: 函数执行正常
+ * \retval XFSERROR: 函数执行异常
+ *
+ * \note 流式合成期间只能调用XFS5152CE_Stop（同时结束流式合成）和XFS5152CE_Stream_*函数
+ */
+XFSResult XFS5152CE_Stream_Start(const uint8_t * XFData, uint16_t XFCount)
+{
+	XFS_StreamData = XFData;
+	XFS_StreamLeft = XFCount;
+	XFS_StreamCache = 0;
+	if(XFCount == 0)
+		return XFSOK;
+	return _XF_StreamSend();
+}
+
+/**
+ * 开始通过文本缓存的流式合成，写入并播放第一段后立即返回，之后在主循环中调用XFS5152CE_Stream_Poll，
+ * 上一段播放结束时写入并播放下一段
+ *
+ * \param XFData: 待合成文本头指针，UNICODE编码（UTF-16，低字节在前），合成期间需保持有效
+ * \param XFCount: 字符个数（字节数的一半）
+ *
+ * \return 函数执行结果
+ * \retval XFSOK: 函数执行正常
+ * \retval XFSERROR: 函数执行异常
+ *
+ * \note 与XFS5152CE_Stream_Start相同，合成期间只能调用XFS5152CE_Stop和XFS5152CE_Stream_*函数
+ */
+XFSResult XFS5152CE_Cache_Start(const uint8_t * XFData, uint16_t XFCount)
+{
+	XFS_StreamData = XFData;
+	XFS_StreamLeft = XFCount;
+	XFS_StreamCache = 1;
+	if(XFCount == 0)
+		return XFSOK;
+	return _XF_StreamSend();
+}
+
+/**
+ * 流式合成时定期调用：BUSY由高变低（上一帧合成结束）时发送下一帧（XFS5152CE_Cache_Start时为下一段）。
+ * 调用间隔即帧之间的最长停顿，一般为几ms
+ *
+ * \return 函数执行结果
+ * \retval XFSOK: 函数执行正常
+ * \retval XFSERROR: 函数执行异常，流式合成结束
+ */
+XFSResult XFS5152CE_Stream_Poll()
+{
+	uint16_t t1;
+	
+	if(XFS_StreamLeft == 0)
+		return XFSOK;
+	
+	if(XFS_StreamBusy == 1)
+	{
+		if(XFS5152CE_BUSY)
+			return XFSOK;
+		return _XF_StreamSend();
+	}
+	
+	/* 发送后BUSY变为高电平之前不能判断为合成结束，否则会打断刚发送的一帧；
+	   一直看不到高电平时不能无限等待，每隔XFS_STREAM_BUSY_TIMEOUT发送一次状态查询 */
+	if(XFS_StreamBusy == 0 && XFS5152CE_BUSY)
+	{
+		XFS_StreamBusy = 1;
+		return XFSOK;
+	}
+	t1 = HAL_I2C_TICKS();
+	XFS_StreamWait += (uint16_t)(t1 - XFS_StreamT0);
+	XFS_StreamT0 = t1;
+	if(XFS_StreamWait <= XFS_STREAM_BUSY_TICKS)
+		return XFSOK;
+	XFS_StreamBusy = 2;
+	XFS_StreamWait = 0;
+	if(_XF_QueryReady() != XFSOK)
+		return XFSOK;
+	return _XF_StreamSend();
+}
+
+/**
+ * 流式合成尚未发送的字符个数
+ *
+ * \return 尚未发送的字符个数，为0时所有帧已发送完成
+ */
+uint16_t XFS5152CE_Stream_Left()
+{
+	return XFS_StreamLeft;
+}
+
 /**
  * 设置音量
  * 
@@ -225,7 +410,6 @@ XFSResult XFS5152CE_Start(uint8_t * XFData, uint8_t XFCount)
  */
 XFSResult XFS5152CE_Volume(uint8_t XFVolume)
 {
-	uint16_t i; 
 	/* [v?] */
 	XFS_Buffer[0] = XFS_FH;
 	XFS_Buffer[1] = 0x00;
@@ -477,6 +661,21 @@ XFSResult _XF_GetResult()
 	}
 }
 
+/* 状态查询，芯片空闲时返回XFSOK */
+XFSResult _XF_QueryReady()
+{
+	XFS_Buffer[0] = XFS_FH;
+	XFS_Buffer[1] = 0x00;
+	XFS_Buffer[2] = 0x01;
+	XFS_Buffer[3] = XFS_CMD_State;
+	XFS5152CE_SEND_BYTES(XFS_Buffer, 4);
+	
+	/* 读取失败时不能判断为空闲 */
+	XFS_tmpRe = XFS_RE_Busy;
+	XFS5152CE_READ_BYTE(&XFS_tmpRe);
+	return XFS_tmpRe == XFS_RE_Ready ? XFSOK : XFSERROR;
+}
+
 /* 生成提示音基本部分数据 */
 void _XF_FillTone()
 {
@@ -498,3 +697,157 @@ void _XF_FillTone()
 	XFS_Buffer[14] = 0x00;
 }
 
+/* 流式合成：发送下一帧（或写入并播放下一段），帧头在局部数组中，文本直接从调用者的数组发送 */
+XFSResult _XF_StreamSend()
+{
+	uint8_t head[5];
+	uint16_t n, len;
+	XFSResult re;
+	
+	if(XFS_StreamCache)
+	{
+		n = _XF_CacheChunk();
+		len = 2 * n;
+		re = _XF_CachePlay(XFS_StreamData, n);
+	}
+	else
+	{
+		n = _XF_StreamChunk();
+		len = 2 * n;
+		head[0] = XFS_FH;
+		head[1] = (uint8_t)((len + 2) >> 8);
+		head[2] = (uint8_t)(len + 2);
+		head[3] = XFS_CMD_Start;
+		head[4] = XFS_FORMAT_UNICODE;  /* 使用UNICODE编码 */
+		
+		XFS5152CE_SEND_FRAME(head, 5, XFS_StreamData, len);
+		re = _XF_GetResult();
+	}
+	XFS_StreamData += len;
+	XFS_StreamLeft -= n;
+	XFS_StreamBusy = 0;
+	XFS_StreamWait = 0;
+	XFS_StreamT0 = HAL_I2C_TICKS();
+	if(re != XFSOK)
+	{
+		XFS_StreamLeft = 0;
+		return XFSERROR;
+	}
+	return XFSOK;
+}
+
+/* 将XFCount个字符写入文本缓存并播放。每块一帧，从第0块开始写入；
+   芯片播放缓存期间写入会改变正在播放的文本，因此只在芯片空闲时调用 */
+XFSResult _XF_CachePlay(const uint8_t * XFData, uint16_t XFCount)
+{
+	uint8_t head[5];
+	uint16_t i, k;
+	uint16_t len = 2 * XFCount;
+	
+	for(i = 0;i < len;i += k)
+	{
+		k = len - i < XFS_CACHE_BLOCK ? len - i : XFS_CACHE_BLOCK;
+		head[0] = XFS_FH;
+		head[1] = (uint8_t)((k + 2) >> 8);
+		head[2] = (uint8_t)(k + 2);
+		head[3] = XFS_CMD_Cache;
+		head[4] = (uint8_t)(i / XFS_CACHE_BLOCK);
+		
+		XFS5152CE_SEND_FRAME(head, 5, XFData + i, k);
+		if(_XF_GetResult() != XFSOK)
+			return XFSERROR;
+	}
+	
+	/* 播放一次，使用UNICODE编码 */
+	head[0] = XFS_FH;
+	head[1] = 0x00;
+	head[2] = 0x02;
+	head[3] = XFS_CMD_CachePlay;
+	head[4] = 0x10 | XFS_FORMAT_UNICODE;
+	XFS5152CE_SEND_BYTES(head, 5);
+	return _XF_GetResult();
+}
+
+/* 阻塞调用XFS5152CE_Stream_Poll，直到所有帧已发送 */
+XFSResult _XF_StreamFinish()
+{
+	while(XFS_StreamLeft != 0)
+	{
+		if(XFS5152CE_Stream_Poll() != XFSOK)
+			return XFSERROR;
+	}
+	return XFSOK;
+}
+
+/* 流式合成：下一帧的字符个数，XFS_STREAM_MIN_CHARS~XFS_STREAM_CHARS范围内第一个标点符号为止。
+   帧越短发送时间越短，拆分处又是语句本身的停顿，帧之间的停顿不明显 */
+uint16_t _XF_StreamChunk()
+{
+	uint16_t i, n;
+	uint16_t c;
+	
+	n = XFS_StreamLeft < XFS_STREAM_CHARS ? XFS_StreamLeft : XFS_STREAM_CHARS;
+	for(i = XFS_STREAM_MIN_CHARS - 1;i < n;i++)
+	{
+		c = XFS_StreamData[2 * i] | ((uint16_t)XFS_StreamData[2 * i + 1] << 8);
+		if(_XF_IsBreak(c))
+			return i + 1;
+	}
+	if(XFS_StreamLeft <= XFS_STREAM_CHARS)
+		return XFS_StreamLeft;
+	
+	/* 没有标点符号时按长度拆分，不拆开UTF-16代理对 */
+	c = XFS_StreamData[2 * XFS_STREAM_CHARS - 2] | ((uint16_t)XFS_StreamData[2 * XFS_STREAM_CHARS - 1] << 8);
+	if(c >= 0xD800 && c <= 0xDBFF)
+		return XFS_STREAM_CHARS - 1;
+	return XFS_STREAM_CHARS;
+}
+
+/* 流式合成：下一段写入文本缓存的字符个数，超过XFS_CACHE_CHARS时在此范围内最后一个标点符号处分段，
+   使分段数最少，分段处的停顿（写入下一段的时间）与语句本身的停顿重合 */
+uint16_t _XF_CacheChunk()
+{
+	uint16_t i;
+	uint16_t c;
+	
+	if(XFS_StreamLeft <= XFS_CACHE_CHARS)
+		return XFS_StreamLeft;
+	
+	for(i = XFS_CACHE_CHARS;i >= XFS_STREAM_MIN_CHARS;i--)
+	{
+		c = XFS_StreamData[2 * i - 2] | ((uint16_t)XFS_StreamData[2 * i - 1] << 8);
+		if(_XF_IsBreak(c))
+			return i;
+	}
+	
+	/* 没有标点符号时按长度分段，不拆开UTF-16代理对 */
+	c = XFS_StreamData[2 * XFS_CACHE_CHARS - 2] | ((uint16_t)XFS_StreamData[2 * XFS_CACHE_CHARS - 1] << 8);
+	if(c >= 0xD800 && c <= 0xDBFF)
+		return XFS_CACHE_CHARS - 1;
+	return XFS_CACHE_CHARS;
+}
+
+/* 是否为可以拆分的标点符号 */
+uint8_t _XF_IsBreak(uint16_t XFChar)
+{
+	switch(XFChar)
+	{
+		case 0x3002:  /* 。 */
+		case 0xFF0C:  /* ， */
+		case 0xFF01:  /* ！ */
+		case 0xFF1F:  /* ？ */
+		case 0xFF1B:  /* ； */
+		case 0xFF1A:  /* ： */
+		case 0x3001:  /* 、 */
+		case 0x002C:  /* , */
+		case 0x002E:  /* . */
+		case 0x0021:  /* ! */
+		case 0x003F:  /* ? */
+		case 0x003B:  /* ; */
+		case 0x000A:  /* 换行 */
+			return 1;
+		
+		default:
+			return 0;
+	}
+}
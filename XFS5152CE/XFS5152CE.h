@@ -19,13 +19,25 @@
  * 目前未实现以下功能：\n
  * 1.语音编解码功能\n
  * 2.语音识别功能\n
- * 3.文本缓存功能\n
- * 4.省电模式（此部分功能数据手册给出的信息不全，进入省电模式后唤醒有问题）\n
+ * 3.省电模式（此部分功能数据手册给出的信息不全，进入省电模式后唤醒有问题）\n
  *
  * 修改记录：\n
  *
  * 2015-09-26 :\n
  *   -修改注释格式使其可以使用Doxygen\n
+ *
+ * 2026-10-18 :\n
+ *   -帧长度改为16位，XFS_BUFFER_SIZE不再限制为小于100\n
+ *   -发送数据改为I2CWriteBlock，一帧可以超过255字节\n
+ *   -增加XFS5152CE_Speak及XFS5152CE_Stream_*，任意长度文本按标点拆分为多帧，
+ *    根据BUSY引脚在上一帧合成结束时立即发送下一帧\n
+ *   -流式合成等待BUSY变为高电平超时后改用状态查询，拆分时每帧至少XFS_STREAM_MIN_CHARS个字符\n
+ *   -流式合成改为在第一个标点符号处拆分，缩短每次帧间停顿\n
+ *   -增加XFS5152CE_Cache_Start、XFS5152CE_Cache_Speak，文本分块写入芯片的文本缓存后整段播放，
+ *    段内没有帧间停顿\n
+ *   -XFS5152CE_Start的字符个数改为16位，与XFS_BUFFER_SIZE的范围一致\n
+ *   -列出底层需要实现的全部操作，包括XFS5152CE_SEND_FRAME及HAL_I2C_TICKS计时\n
+ *   -增加I2C_HOST仿真环境的底层定义\n
  * 
  */
  
@@ -34,25 +46,64 @@
 
 /*--------------------此部分需要修改--------------------*/
 /* 如未定义uint8_t等基本数据类型，需要先定义 */
+#ifndef I2C_HOST
 #include "TypeDef.h"
+#endif
 
 /* 底层HAL头文件 */
 #include "GPIO_I2C.h"
+#ifndef I2C_HOST
 #include "STC15F2K60S2.h"
+#endif
 
 /**
- * 数据缓存区大小，一次能发送的中文个数最多为 XFS_BUFFER_SIZE / 2 个
+ * 数据缓存区大小，XFS5152CE_Start一次能发送的中文个数最多为 XFS_BUFFER_SIZE / 2 个，
+ * 更长的文本使用XFS5152CE_Speak
  *
  * \warning
- * -XFS_BUFFER_SIZE要小于100，否则程序中某些地方会发生溢出;\n
+ * -XFS_BUFFER_SIZE不能超过4000（芯片一帧最多4K字节）;\n
  * -为支持文本控制标记，XFS_BUFFER_SIZE需要大于16.
  */
 #define XFS_BUFFER_SIZE 50
+
+/**
+ * XFS5152CE_Speak每帧最多的字符数，在XFS_STREAM_MIN_CHARS之后的第一个标点符号处拆分，
+ * 此范围内没有标点符号时按此长度拆分。文本直接从调用者的数组发送，不占用数据缓存区。
+ * 芯片合成中收到新的文本会打断当前合成，下一帧只能在上一帧合成结束后发送，
+ * 帧之间的停顿为一帧的发送时间（100kHz时每个字符约0.2ms）加上XFS5152CE_Stream_Poll的调用间隔；
+ * 按标点符号拆分使每帧较短，停顿又与语句本身的停顿重合。需要完全消除帧间停顿时使用XFS5152CE_Cache_*。
+ * 不能超过2000
+ */
+#define XFS_STREAM_CHARS 100
+
+/**
+ * 拆分时每帧最少的字符数，此前的标点符号不作为拆分位置，避免“啊，”等很短的帧。
+ * 取值范围：[1, XFS_STREAM_CHARS]
+ */
+#define XFS_STREAM_MIN_CHARS 8
+
+/**
+ * 流式合成发送一帧后等待BUSY变为高电平的最长时间(ms)。BUSY引脚未连接或损坏时始终为低电平，
+ * 超时后改为每隔此时间发送一次状态查询命令，芯片空闲时再发送下一帧。
+ * 按GPIO_I2C.h中的HAL_I2C_TICKS计时，XFS5152CE_Stream_Poll的调用间隔超过计数器回绕周期时实际等待更长
+ */
+#define XFS_STREAM_BUSY_TIMEOUT 20
+
+/**
+ * XFS5152CE_Cache_*每段最多的字符数。每段先写入芯片的文本缓存（4K字节，每块256字节一帧），
+ * 再用一条播放命令整段合成，段内没有帧间停顿；开始播放前需等待整段写入，
+ * 100kHz时每个字符约0.2ms。超过此长度的文本在此范围内最后一个标点符号处分段。
+ * 取值范围：[XFS_STREAM_MIN_CHARS, 2048]
+ */
+#define XFS_CACHE_CHARS 2048
  
-/* 底层HAL文件中需要实现3个基本操作：
- * 1.发送一段数据（以字节数组的形式）
- * 2.读取一个字节数据
- * 3.返回RDY引脚电平
+/* 底层HAL文件中需要实现以下操作：
+ * 1.发送一段数据（以字节数组的形式），XFS5152CE_SEND_BYTES
+ * 2.在一帧中连续发送帧头和文本两段数据，XFS5152CE_SEND_FRAME
+ * 3.读取一个字节数据，XFS5152CE_READ_BYTE
+ * 4.返回RDY引脚电平，XFS5152CE_BUSY
+ * 5.流式合成的等待计时，使用GPIO_I2C.h中的HAL_I2C_TICKS()及HAL_I2C_TICK_HZ，
+ *   不使用GPIO_I2C时需另外提供这两个宏定义
  */
  
 /**
@@ -60,7 +111,16 @@
  * \param XFSData: 待发送数据指针
  * \param XFSCount: 数据个数
  */
-#define XFS5152CE_SEND_BYTES(XFSData,XFSCount) I2CWriteMultiBytes(0x40,XFSCount,XFSData)
+#define XFS5152CE_SEND_BYTES(XFSData,XFSCount) I2CWriteBlock(0x40,0,0,XFSCount,XFSData)
+
+/**
+ * 在一帧中连续发送帧头和文本两段数据宏定义
+ * \param XFSHead: 帧头指针
+ * \param XFSHeadCount: 帧头字节数
+ * \param XFSData: 文本指针
+ * \param XFSCount: 文本字节数
+ */
+#define XFS5152CE_SEND_FRAME(XFSHead,XFSHeadCount,XFSData,XFSCount) I2CWriteBlock(0x40,XFSHeadCount,XFSHead,XFSCount,XFSData)
 
 /**
  * 读取一个字节数据宏定义
@@ -76,7 +136,12 @@
  *
  * \note 程序中可直接调用此宏来判断是否发送新数据
  */
+#ifdef I2C_HOST
+/* Linux主机仿真，BUSY引脚为I2CHostXfsPin所指的替身模型的状态 */
+#define XFS5152CE_BUSY I2CHostXfsBusyRead()
+#else
 #define XFS5152CE_BUSY P42
+#endif
 
 /*--------------------此部分需要修改--------------------*/
 
@@ -128,7 +193,7 @@ XFSResult XFS5152CE_Pause();
 XFSResult XFS5152CE_Resume();
 
 /**
- * 停止语音合成
+ * 停止语音合成，流式合成时同时结束流式合成
  * 
  * \return 函数执行结果
  * \retval XFSOK: 函数执行正常
@@ -140,7 +205,7 @@ XFSResult XFS5152CE_Stop();
  * 开始语音合成
  * 
  * \param XFData: 待合成数据头指针
- * \param XFCount: 待合成数据个数，需小于XFS_BUFFER_SIZE / 2
+ * \param XFCount: 待合成数据个数，不能超过XFS_BUFFER_SIZE / 2
  *
  * \note XFCount为实际中文字符字数，不是字节数，一般XFCount为字节数的一半
  * 
@@ -148,7 +213,85 @@ XFSResult XFS5152CE_Stop();
  * \retval XFSOK: 函数执行正常
  * \retval XFSERROR: 函数执行异常
  */
-XFSResult XFS5152CE_Start(uint8_t * XFData, uint8_t XFCount);
+XFSResult XFS5152CE_Start(uint8_t * XFData, uint16_t XFCount);
+
+/**
+ * 合成任意长度的文本，阻塞直到最后一帧发送完成（此时最后一帧正在合成）。
+ * 文本按XFS_STREAM_CHARS及标点符号拆分为多帧，上一帧合成结束（BUSY变为低电平）时立即发送下一帧
+ *
+ * \param XFData: 待合成文本头指针，UNICODE编码（UTF-16，低字节在前）
+ * \param XFCount: 字符个数（字节数的一半）
+ *
+ * \return 函数执行结果
+ * \retval XFSOK: 函数执行正常
+ * \retval XFSERROR: 函数执行异常，之后的文本不再发送
+ *
+ * \note 文本控制标记（如[v5]）不要跨越拆分位置，可在标记前加标点符号
+ */
+XFSResult XFS5152CE_Speak(const uint8_t * XFData, uint16_t XFCount);
+
+/**
+ * 开始流式合成，发送第一帧后立即返回，之后在主循环中调用XFS5152CE_Stream_Poll发送其余各帧
+ *
+ * \param XFData: 待合成文本头指针，UNICODE编码（UTF-16，低字节在前），合成期间需保持有效
+ * \param XFCount: 字符个数（字节数的一半）
+ *
+ * \return 函数执行结果
+ * \retval XFSOK: 函数执行正常
+ * \retval XFSERROR: 函数执行异常
+ *
+ * \note 流式合成期间只能调用XFS5152CE_Stop（同时结束流式合成）和XFS5152CE_Stream_*函数
+ */
+XFSResult XFS5152CE_Stream_Start(const uint8_t * XFData, uint16_t XFCount);
+
+/**
+ * 通过芯片的文本缓存合成任意长度的文本，阻塞直到最后一段开始播放。
+ * 文本按XFS_CACHE_CHARS分段，每段写入缓存后整段播放，段内没有帧间停顿
+ *
+ * \param XFData: 待合成文本头指针，UNICODE编码（UTF-16，低字节在前）
+ * \param XFCount: 字符个数（字节数的一半）
+ *
+ * \return 函数执行结果
+ * \retval XFSOK: 函数执行正常
+ * \retval XFSERROR: 函数执行异常，之后的文本不再发送
+ *
+ * \note 文本控制标记（如[v5]）不要跨越分段位置
+ */
+XFSResult XFS5152CE_Cache_Speak(const uint8_t * XFData, uint16_t XFCount);
+
+/**
+ * 开始通过文本缓存的流式合成，写入并播放第一段后立即返回，之后在主循环中调用XFS5152CE_Stream_Poll，
+ * 上一段播放结束时写入并播放下一段
+ *
+ * \param XFData: 待合成文本头指针，UNICODE编码（UTF-16，低字节在前），合成期间需保持有效
+ * \param XFCount: 字符个数（字节数的一半）
+ *
+ * \return 函数执行结果
+ * \retval XFSOK: 函数执行正常
+ * \retval XFSERROR: 函数执行异常
+ *
+ * \note 与XFS5152CE_Stream_Start相同，合成期间只能调用XFS5152CE_Stop和XFS5152CE_Stream_*函数
+ */
+XFSResult XFS5152CE_Cache_Start(const uint8_t * XFData, uint16_t XFCount);
+
+/**
+ * 流式合成时定期调用：BUSY由高变低（上一帧合成结束）时发送下一帧（XFS5152CE_Cache_Start时为下一段）；
+ * 发送后超过XFS_STREAM_BUSY_TIMEOUT未看到BUSY为高电平时，改为每隔XFS_STREAM_BUSY_TIMEOUT发送一次状态查询，
+ * 芯片空闲时发送下一帧。
+ * 调用间隔即帧之间的最长停顿，一般为几ms
+ *
+ * \return 函数执行结果
+ * \retval XFSOK: 函数执行正常
+ * \retval XFSERROR: 函数执行异常，流式合成结束
+ */
+XFSResult XFS5152CE_Stream_Poll();
+
+/**
+ * 流式合成尚未发送的字符个数
+ *
+ * \return 尚未发送的字符个数，为0时所有帧已发送完成
+ */
+uint16_t XFS5152CE_Stream_Left();
 
 /**
  * 设置音量